@@ -0,0 +1,53 @@
+#!/usr/bin/env bash
+# Climbing load test: one headless dedicated server plus N bot clients on this machine.
+#
+# Usage: UE_ROOT=/path/to/UnrealEngine Scripts/ClimbLoadTest.sh [clients] [seconds] [lag ms] [loss %] [climb|basic]
+#
+# Clients and server both emulate the given latency and packet loss (non-shipping builds only).
+# The server logs tick time, replication time, corrections and bytes per second per client every
+# few seconds, grep Saved/Logs/ClimbLoadTestServer.log for "ClimbLoadTest:". Run once with "climb"
+# and once with "basic" to compare the climb replication node against the default 2D grid.
+
+set -euo pipefail
+
+NUM_CLIENTS=${1:-8}
+DURATION=${2:-120}
+PKT_LAG=${3:-60}
+PKT_LOSS=${4:-1}
+REP_GRAPH=${5:-climb}
+
+PROJECT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+PROJECT="$PROJECT_DIR/ClimbingSystem.uproject"
+EDITOR="${UE_ROOT:?Set UE_ROOT to the engine root}/Engine/Binaries/Linux/UnrealEditor"
+MAP="/Game/ThirdPerson/Maps/ThirdPersonMap"
+PORT=7777
+
+NET_EMULATION=(-PktLag="$PKT_LAG" -PktLagVariance=$((PKT_LAG / 4)) -PktLoss="$PKT_LOSS")
+
+REP_GRAPH_ARGS=()
+if [[ "$REP_GRAPH" == "basic" ]]; then
+    REP_GRAPH_ARGS=(-dpcvars=climb.RepGraph.ClimbNode=0)
+fi
+
+"$EDITOR" "$PROJECT" "$MAP?game=/Script/ClimbingSystem.ClimbLoadTestGameMode" \
+    -server -nullrhi -unattended -port=$PORT \
+    -ClimbLoadTestDuration="$DURATION" \
+    "${NET_EMULATION[@]}" \
+    "${REP_GRAPH_ARGS[@]}" \
+    -log=ClimbLoadTestServer.log &
+SERVER_PID=$!
+
+trap 'kill $(jobs -p) 2>/dev/null || true' EXIT
+
+# Give the server time to load the map before clients connect
+sleep 15
+
+for ((i = 0; i < NUM_CLIENTS; i++)); do
+    "$EDITOR" "$PROJECT" 127.0.0.1:$PORT \
+        -game -nullrhi -nosound -unattended \
+        -ClimbBot -ClimbBotSeed=$i \
+        "${NET_EMULATION[@]}" \
+        -log=ClimbLoadTestClient$i.log &
+done
+
+wait $SERVER_PID
@@ -1,7 +1,36 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "ClimbingSystem.h"
-#include "Modules/ModuleManager.h"
-
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ClimbingSystem, "ClimbingSystem" );
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingSystem.h"
+#include "Modules/ModuleManager.h"
+#include "ClimbingSystemStats.h"
+
+LLM_DEFINE_TAG(ClimbingSystem);
+
+DEFINE_STAT(STAT_ClimbQueriesIssued);
+DEFINE_STAT(STAT_ClimbProbesDeferred);
+DEFINE_STAT(STAT_ClimbSlideIterations);
+DEFINE_STAT(STAT_ClimbActiveClimbers);
+DEFINE_STAT(STAT_ClimbMontageLoadLatency);
+DEFINE_STAT(STAT_ClimbMontageSyncLoads);
+DEFINE_STAT(STAT_ClimbRepGraphReducedRate);
+DEFINE_STAT(STAT_ClimbRepGraphGather);
+DEFINE_STAT(STAT_ClimbClientCorrections);
+DEFINE_STAT(STAT_ClimbReplayProbesReused);
+DEFINE_STAT(STAT_ClimbAutoTraversalQueries);
+DEFINE_STAT(STAT_ClimbIntentLatency);
+DEFINE_STAT(STAT_ClimbRedundantProbesSkipped);
+DEFINE_STAT(STAT_ClimbNavBuild);
+DEFINE_STAT(STAT_ClimbNavPathQuery);
+DEFINE_STAT(STAT_ClimbNavPathCacheHits);
+DEFINE_STAT(STAT_ClimbNavPathCacheMisses);
+DEFINE_STAT(STAT_ClimbSurfaceMaterialCacheHits);
+DEFINE_STAT(STAT_ClimbSurfaceMaterialCacheMisses);
+DEFINE_STAT(STAT_ClimbIKQueries);
+DEFINE_STAT(STAT_ClimbCameraProbes);
+DEFINE_STAT(STAT_ClimbStreamingHolds);
+DEFINE_STAT(STAT_ClimbMoveSweeps);
+DEFINE_STAT(STAT_ClimbIntentsExpired);
+DEFINE_STAT(STAT_ClimbScheduleQueries);
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ClimbingSystem, "ClimbingSystem" );
  
\ No newline at end of file
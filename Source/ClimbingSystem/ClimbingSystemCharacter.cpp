@@ -1,185 +1,309 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "ClimbingSystemCharacter.h"
-#include "Engine/LocalPlayer.h"
-#include "Camera/CameraComponent.h"
-#include "Components/CapsuleComponent.h"
-#include "CustomMovementComponent.h"
-#include "GameFramework/SpringArmComponent.h"
-#include "GameFramework/Controller.h"
-#include "EnhancedInputComponent.h"
-#include "EnhancedInputSubsystems.h"
-#include "InputActionValue.h"
-#include "DebugHelper.h"
-
-DEFINE_LOG_CATEGORY(LogTemplateCharacter);
-
-//////////////////////////////////////////////////////////////////////////
-// AClimbingSystemCharacter
-
-AClimbingSystemCharacter::AClimbingSystemCharacter(const FObjectInitializer& ObjectInitializer)
-	:Super(ObjectInitializer.SetDefaultSubobjectClass<UCustomMovementComponent>(ACharacter::CharacterMovementComponentName))
-{
-	// Set size for collision capsule
-	GetCapsuleComponent()->InitCapsuleSize(42.f, 90.0f);
-		
-	// Don't rotate when the controller rotates. Let that just affect the camera.
-	bUseControllerRotationPitch = false;
-	bUseControllerRotationYaw = false;
-	bUseControllerRotationRoll = false;
-
-	// Cast CharacterMovement pointer to CustomMovementComponent pointer.
-	CustomMovementComponent = Cast<UCustomMovementComponent>(GetCharacterMovement());
-	// Configure character movement
-	GetCharacterMovement()->bOrientRotationToMovement = true; // Character moves in the direction of input...	
-	GetCharacterMovement()->RotationRate = FRotator(0.0f, 500.0f, 0.0f); // ...at this rotation rate
-
-	// Note: For faster iteration times these variables, and many more, can be tweaked in the Character Blueprint
-	// instead of recompiling to adjust them
-	GetCharacterMovement()->JumpZVelocity = 700.f;
-	GetCharacterMovement()->AirControl = 0.35f;
-	GetCharacterMovement()->MaxWalkSpeed = 500.f;
-	GetCharacterMovement()->MinAnalogWalkSpeed = 20.f;
-	GetCharacterMovement()->BrakingDecelerationWalking = 2000.f;
-	GetCharacterMovement()->BrakingDecelerationFalling = 1500.0f;
-
-	// Create a camera boom (pulls in towards the player if there is a collision)
-	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
-	CameraBoom->SetupAttachment(RootComponent);
-	CameraBoom->TargetArmLength = 400.0f; // The camera follows at this distance behind the character	
-	CameraBoom->bUsePawnControlRotation = true; // Rotate the arm based on the controller
-
-	// Create a follow camera
-	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
-	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
-	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
-
-	// Note: The skeletal mesh and anim blueprint references on the Mesh component (inherited from Character) 
-	// are set in the derived blueprint asset named ThirdPersonCharacter (to avoid direct content references in C++)
-}
-
-void AClimbingSystemCharacter::BeginPlay()
-{
-	// Call the base class  
-	Super::BeginPlay();
-}
-
-//////////////////////////////////////////////////////////////////////////
-// Input
-
-void AClimbingSystemCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
-{
-	// Add Input Mapping Context
-	if (APlayerController* PlayerController = Cast<APlayerController>(GetController()))
-	{
-		if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))
-		{
-			Subsystem->AddMappingContext(DefaultMappingContext, 0);
-		}
-	}
-	
-	// Set up action bindings
-	if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerInputComponent)) {
-		
-		// Jumping
-		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Started, this, &ACharacter::Jump);
-		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Completed, this, &ACharacter::StopJumping);
-
-		// Moving
-		EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Triggered, this, &AClimbingSystemCharacter::Move);
-
-		// Looking
-		EnhancedInputComponent->BindAction(LookAction, ETriggerEvent::Triggered, this, &AClimbingSystemCharacter::Look);
-		
-		// Climbing
-		EnhancedInputComponent->BindAction(ClimbAction, ETriggerEvent::Started, this, &AClimbingSystemCharacter::OnClimbActionStarted);
-	}
-	else
-	{
-		UE_LOG(LogTemplateCharacter, Error, TEXT("'%s' Failed to find an Enhanced Input component! This template is built to use the Enhanced Input system. If you intend to use the legacy system, then you will need to update this C++ file."), *GetNameSafe(this));
-	}
-}
-
-void AClimbingSystemCharacter::Move(const FInputActionValue& Value)
-{
-
-	if (!CustomMovementComponent) return;
-
-	if (CustomMovementComponent->IsClimbing())
-	{
-		HandleClimbMovementInput(Value);
-	}
-	else
-	{
-		HandleGroundMovementInput(Value);
-	}
-}
-
-void AClimbingSystemCharacter::HandleGroundMovementInput(const FInputActionValue& Value)
-{
-	// input is a Vector2D
-	const FVector2D MovementVector = Value.Get<FVector2D>();
-
-	if (Controller != nullptr)
-	{
-		// find out which way is forward
-		const FRotator Rotation = Controller->GetControlRotation();
-		const FRotator YawRotation(0, Rotation.Yaw, 0);
-
-		// get forward vector
-		const FVector ForwardDirection = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::X);
-
-		// get right vector 
-		const FVector RightDirection = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::Y);
-
-		// add movement 
-		AddMovementInput(ForwardDirection, MovementVector.Y);
-		AddMovementInput(RightDirection, MovementVector.X);
-	}
-}
-
-void AClimbingSystemCharacter::HandleClimbMovementInput(const FInputActionValue& Value)
-{
-	const FVector2D MovementVector = Value.Get<FVector2D>();
-
-	const FVector ForwardDirection{
-		FVector::CrossProduct(
-			-CustomMovementComponent->GetClimbableSurfaceNormal(),
-			GetActorRightVector())
-	};
-
-	const FVector RightDirection{
-		FVector::CrossProduct(
-			-CustomMovementComponent->GetClimbableSurfaceNormal(),
-			-GetActorUpVector())
-	};
-
-	AddMovementInput(ForwardDirection, MovementVector.Y);
-	AddMovementInput(RightDirection, MovementVector.X);
-}
-
-void AClimbingSystemCharacter::Look(const FInputActionValue& Value)
-{
-	// input is a Vector2D
-	FVector2D LookAxisVector = Value.Get<FVector2D>();
-
-	if (Controller != nullptr)
-	{
-		// add yaw and pitch input to controller
-		AddControllerYawInput(LookAxisVector.X);
-		AddControllerPitchInput(LookAxisVector.Y);
-	}
-}
-
-void AClimbingSystemCharacter::OnClimbActionStarted(const FInputActionValue& Value)
-{
-	if (!CustomMovementComponent) return;
-	if (!CustomMovementComponent->IsClimbing())
-	{
-		CustomMovementComponent->ToggleToClimbing(true);
-	}
-	else
-	{
-		CustomMovementComponent->ToggleToClimbing(false);
-	}
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingSystemCharacter.h"
+#include "Engine/LocalPlayer.h"
+#include "Camera/CameraComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "CustomMovementComponent.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "GameFramework/Controller.h"
+#include "EnhancedInputComponent.h"
+#include "EnhancedInputSubsystems.h"
+#include "InputActionValue.h"
+#include "DebugHelper.h"
+#include "ClimbingSystemStats.h"
+
+DEFINE_LOG_CATEGORY(LogTemplateCharacter);
+
+//////////////////////////////////////////////////////////////////////////
+// AClimbingSystemCharacter
+
+AClimbingSystemCharacter::AClimbingSystemCharacter(const FObjectInitializer& ObjectInitializer)
+	:Super(ObjectInitializer.SetDefaultSubobjectClass<UCustomMovementComponent>(ACharacter::CharacterMovementComponentName))
+{
+	// Set size for collision capsule
+	GetCapsuleComponent()->InitCapsuleSize(42.f, 90.0f);
+		
+	// Don't rotate when the controller rotates. Let that just affect the camera.
+	bUseControllerRotationPitch = false;
+	bUseControllerRotationYaw = false;
+	bUseControllerRotationRoll = false;
+
+	// Cast CharacterMovement pointer to CustomMovementComponent pointer.
+	CustomMovementComponent = Cast<UCustomMovementComponent>(GetCharacterMovement());
+	// Configure character movement
+	GetCharacterMovement()->bOrientRotationToMovement = true; // Character moves in the direction of input...	
+	GetCharacterMovement()->RotationRate = FRotator(0.0f, 500.0f, 0.0f); // ...at this rotation rate
+
+	// Note: For faster iteration times these variables, and many more, can be tweaked in the Character Blueprint
+	// instead of recompiling to adjust them
+	GetCharacterMovement()->JumpZVelocity = 700.f;
+	GetCharacterMovement()->AirControl = 0.35f;
+	GetCharacterMovement()->MaxWalkSpeed = 500.f;
+	GetCharacterMovement()->MinAnalogWalkSpeed = 20.f;
+	GetCharacterMovement()->BrakingDecelerationWalking = 2000.f;
+	GetCharacterMovement()->BrakingDecelerationFalling = 1500.0f;
+
+	// Create a camera boom (pulls in towards the player if there is a collision)
+	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
+	CameraBoom->SetupAttachment(RootComponent);
+	CameraBoom->TargetArmLength = 400.0f; // The camera follows at this distance behind the character	
+	CameraBoom->bUsePawnControlRotation = true; // Rotate the arm based on the controller
+
+	// Create a follow camera
+	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
+	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
+	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
+
+	// Note: The skeletal mesh and anim blueprint references on the Mesh component (inherited from Character) 
+	// are set in the derived blueprint asset named ThirdPersonCharacter (to avoid direct content references in C++)
+}
+
+void AClimbingSystemCharacter::BeginPlay()
+{
+	// Call the base class  
+	Super::BeginPlay();
+
+	DefaultCameraArmLength = CameraBoom->TargetArmLength;
+}
+
+void AClimbingSystemCharacter::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (IsLocallyControlled())
+	{
+		UpdateClimbCamera(DeltaSeconds);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Climb camera
+
+void AClimbingSystemCharacter::UpdateClimbCamera(float DeltaSeconds)
+{
+	if (!CustomMovementComponent) return;
+
+	const FVector SurfaceNormal{CustomMovementComponent->GetClimbableSurfaceNormal()};
+	const bool bWantsClimbCamera{CustomMovementComponent->IsInClimbTraversal() &&
+		!CustomMovementComponent->IsWallRunning() && !SurfaceNormal.IsZero()};
+
+	if (bWantsClimbCamera != bClimbCameraActive)
+	{
+		bClimbCameraActive = bWantsClimbCamera;
+
+		// The climb camera sweeps on its own schedule instead of every frame
+		CameraBoom->bDoCollisionTest = !bClimbCameraActive;
+		ClimbCameraArmLength = CameraBoom->TargetArmLength;
+		ClimbCameraProbeTimer = 0.f;
+		ClimbCameraProbeNormal = FVector::ZeroVector;
+	}
+
+	// Blend the boom origin out of the wall and back, the arm no longer rubs against the climbed surface
+	const FVector TargetOffset{bClimbCameraActive ? SurfaceNormal * ClimbCameraSurfaceOffset : FVector::ZeroVector};
+	CameraBoom->TargetOffset = FMath::VInterpTo(CameraBoom->TargetOffset, TargetOffset, DeltaSeconds, ClimbCameraInterpSpeed);
+
+	if (!bClimbCameraActive)
+	{
+		CameraBoom->TargetArmLength = FMath::FInterpTo(CameraBoom->TargetArmLength, DefaultCameraArmLength,
+			DeltaSeconds, ClimbCameraInterpSpeed);
+		return;
+	}
+
+	const FQuat ViewRotation{GetControlRotation().Quaternion()};
+	const float StableCos{FMath::Cos(FMath::DegreesToRadians(ClimbCameraStableAngle))};
+
+	const bool bSurfaceChanged{FVector::DotProduct(SurfaceNormal, ClimbCameraProbeNormal) < StableCos};
+	const bool bViewChanged{FMath::Abs(ViewRotation | ClimbCameraProbeRotation) < FMath::Cos(FMath::DegreesToRadians(ClimbCameraStableAngle) * 0.5f)};
+
+	// Climbing along a flat wall changes neither, but carries the arm toward whatever sticks out of it
+	const FVector ProbeOrigin{CameraBoom->GetComponentLocation() + CameraBoom->TargetOffset};
+	const bool bOriginMoved{FVector::DistSquared(ProbeOrigin, ClimbCameraProbeOrigin) > FMath::Square(ClimbCameraStableDistance)};
+
+	ClimbCameraProbeTimer -= DeltaSeconds;
+	if (bSurfaceChanged || bViewChanged || bOriginMoved || ClimbCameraProbeTimer <= 0.f)
+	{
+		ClimbCameraArmLength = SweepClimbCameraArm();
+		ClimbCameraProbeTimer = ClimbCameraProbeInterval;
+		ClimbCameraProbeNormal = SurfaceNormal;
+		ClimbCameraProbeRotation = ViewRotation;
+		ClimbCameraProbeOrigin = ProbeOrigin;
+	}
+
+	// Pull in at once so the camera never ends up inside geometry, ease back out
+	CameraBoom->TargetArmLength = ClimbCameraArmLength < CameraBoom->TargetArmLength ? ClimbCameraArmLength :
+		FMath::FInterpTo(CameraBoom->TargetArmLength, ClimbCameraArmLength, DeltaSeconds, ClimbCameraInterpSpeed);
+}
+
+float AClimbingSystemCharacter::SweepClimbCameraArm() const
+{
+	INC_DWORD_STAT(STAT_ClimbCameraProbes);
+
+	// Same sweep as USpringArmComponent::UpdateDesiredArmLocation, from the offset origin
+	const FVector Origin{CameraBoom->GetComponentLocation() + CameraBoom->TargetOffset};
+	const FVector ArmEnd{Origin - GetControlRotation().Vector() * DefaultCameraArmLength};
+
+	FCollisionQueryParams QueryParams{SCENE_QUERY_STAT(ClimbCameraArm), false, this};
+
+	FHitResult Hit;
+	GetWorld()->SweepSingleByChannel(Hit, Origin, ArmEnd, FQuat::Identity, CameraBoom->ProbeChannel,
+		FCollisionShape::MakeSphere(CameraBoom->ProbeSize), QueryParams);
+
+	return Hit.bBlockingHit ? DefaultCameraArmLength * Hit.Time : DefaultCameraArmLength;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Input
+
+void AClimbingSystemCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
+{
+	// Add Input Mapping Context
+	if (APlayerController* PlayerController = Cast<APlayerController>(GetController()))
+	{
+		if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))
+		{
+			Subsystem->AddMappingContext(DefaultMappingContext, 0);
+		}
+	}
+	
+	// Set up action bindings
+	if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerInputComponent)) {
+		
+		// Jumping
+		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Started, this, &AClimbingSystemCharacter::OnJumpActionStarted);
+		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Completed, this, &ACharacter::StopJumping);
+
+		// Moving
+		EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Triggered, this, &AClimbingSystemCharacter::Move);
+
+		// Looking
+		EnhancedInputComponent->BindAction(LookAction, ETriggerEvent::Triggered, this, &AClimbingSystemCharacter::Look);
+		
+		// Climbing
+		EnhancedInputComponent->BindAction(ClimbAction, ETriggerEvent::Started, this, &AClimbingSystemCharacter::OnClimbActionStarted);
+	}
+	else
+	{
+		UE_LOG(LogTemplateCharacter, Error, TEXT("'%s' Failed to find an Enhanced Input component! This template is built to use the Enhanced Input system. If you intend to use the legacy system, then you will need to update this C++ file."), *GetNameSafe(this));
+	}
+}
+
+void AClimbingSystemCharacter::OnJumpActionStarted(const FInputActionValue& Value)
+{
+	// Sent with the saved move so the server performs it in order with the movement
+	if (CustomMovementComponent && CustomMovementComponent->CanClimbJump())
+	{
+		CustomMovementComponent->RequestClimbJump();
+		return;
+	}
+
+	Jump();
+}
+
+void AClimbingSystemCharacter::Move(const FInputActionValue& Value)
+{
+
+	if (!CustomMovementComponent) return;
+
+	if (CustomMovementComponent->IsInClimbTraversal() && !CustomMovementComponent->IsWallRunning())
+	{
+		HandleClimbMovementInput(Value);
+	}
+	else
+	{
+		HandleGroundMovementInput(Value);
+	}
+}
+
+void AClimbingSystemCharacter::HandleGroundMovementInput(const FInputActionValue& Value)
+{
+	// input is a Vector2D
+	const FVector2D MovementVector = Value.Get<FVector2D>();
+
+	if (Controller != nullptr)
+	{
+		// find out which way is forward
+		const FRotator Rotation = Controller->GetControlRotation();
+		const FRotator YawRotation(0, Rotation.Yaw, 0);
+
+		// get forward vector
+		const FVector ForwardDirection = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::X);
+
+		// get right vector 
+		const FVector RightDirection = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::Y);
+
+		// add movement 
+		AddMovementInput(ForwardDirection, MovementVector.Y);
+		AddMovementInput(RightDirection, MovementVector.X);
+	}
+}
+
+void AClimbingSystemCharacter::HandleClimbMovementInput(const FInputActionValue& Value)
+{
+	const FVector2D MovementVector = Value.Get<FVector2D>();
+
+	const FVector ForwardDirection{
+		FVector::CrossProduct(
+			-CustomMovementComponent->GetClimbableSurfaceNormal(),
+			GetActorRightVector())
+	};
+
+	const FVector RightDirection{
+		FVector::CrossProduct(
+			-CustomMovementComponent->GetClimbableSurfaceNormal(),
+			-GetActorUpVector())
+	};
+
+	AddMovementInput(ForwardDirection, MovementVector.Y);
+	AddMovementInput(RightDirection, MovementVector.X);
+}
+
+void AClimbingSystemCharacter::Look(const FInputActionValue& Value)
+{
+	// input is a Vector2D
+	FVector2D LookAxisVector = Value.Get<FVector2D>();
+
+	if (Controller != nullptr)
+	{
+		// add yaw and pitch input to controller
+		AddControllerYawInput(LookAxisVector.X);
+		AddControllerPitchInput(LookAxisVector.Y);
+	}
+}
+
+void AClimbingSystemCharacter::OnClimbActionStarted(const FInputActionValue& Value)
+{
+	if (!CustomMovementComponent) return;
+	if (!CustomMovementComponent->IsInClimbTraversal())
+	{
+		RequestToggleClimbing(true);
+	}
+	else
+	{
+		RequestToggleClimbing(false);
+	}
+}
+
+void AClimbingSystemCharacter::RequestToggleClimbing(bool bEnableClimb)
+{
+	if (!CustomMovementComponent) return;
+
+	CustomMovementComponent->ToggleToClimbing(bEnableClimb);
+
+	if (!HasAuthority())
+	{
+		ServerToggleClimbing(bEnableClimb);
+	}
+}
+
+void AClimbingSystemCharacter::ServerToggleClimbing_Implementation(bool bEnableClimb)
+{
+	if (!CustomMovementComponent) return;
+
+	CustomMovementComponent->ToggleToClimbing(bEnableClimb);
+}
+
+void AClimbingSystemCharacter::AddMoveInput(const FVector2D& MovementVector)
+{
+	Move(FInputActionValue(MovementVector));
 }
\ No newline at end of file
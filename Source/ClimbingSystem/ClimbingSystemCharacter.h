@@ -1,89 +1,152 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/Character.h"
-#include "Logging/LogMacros.h"
-#include "ClimbingSystemCharacter.generated.h"
-
-class USpringArmComponent;
-class UCameraComponent;
-class UInputMappingContext;
-class UInputAction;
-struct FInputActionValue;
-
-DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
-
-class UCustomMovementComponent;
-
-UCLASS(config=Game)
-class AClimbingSystemCharacter : public ACharacter
-{
-	GENERATED_BODY()
-
-public:
-	AClimbingSystemCharacter(const FObjectInitializer& ObjectInitializer);
-
-private:
-	/** Camera boom positioning the camera behind the character */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
-	USpringArmComponent* CameraBoom;
-
-	/** Follow camera */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
-	UCameraComponent* FollowCamera;
-
-	/** Custom Movement component*/
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
-	UCustomMovementComponent* CustomMovementComponent;
-	
-	/** MappingContext */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
-	UInputMappingContext* DefaultMappingContext;
-
-	/** Jump Input Action */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
-	UInputAction* JumpAction;
-
-	/** Move Input Action */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
-	UInputAction* MoveAction;
-
-	/** Called for movement input */
-	void Move(const FInputActionValue& Value);
-
-	void HandleGroundMovementInput(const FInputActionValue& Value);
-
-	void HandleClimbMovementInput(const FInputActionValue& Value);
-
-	/** Look Input Action */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
-	UInputAction* LookAction;
-
-	/** Called for looking input */
-	void Look(const FInputActionValue& Value);
-
-	/** Climb Input Action */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
-	UInputAction* ClimbAction;
-
-	/** Called for Climbing Input */
-	void OnClimbActionStarted(const FInputActionValue& Value);
-
-protected:
-	// APawn interface
-	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
-	
-	// To add mapping context
-	virtual void BeginPlay();
-
-public:
-	/** Returns CameraBoom subobject **/
-	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
-	/** Returns FollowCamera subobject **/
-	FORCEINLINE class UCameraComponent* GetFollowCamera() const { return FollowCamera; }
-	/** Return CustomMovement subobject */
-	FORCEINLINE UCustomMovementComponent* GetCustomMovement() const { return CustomMovementComponent; }
-};
-
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Character.h"
+#include "Logging/LogMacros.h"
+#include "ClimbingSystemCharacter.generated.h"
+
+class USpringArmComponent;
+class UCameraComponent;
+class UInputMappingContext;
+class UInputAction;
+struct FInputActionValue;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
+
+class UCustomMovementComponent;
+
+UCLASS(config=Game)
+class AClimbingSystemCharacter : public ACharacter
+{
+	GENERATED_BODY()
+
+public:
+	AClimbingSystemCharacter(const FObjectInitializer& ObjectInitializer);
+
+private:
+	/** Camera boom positioning the camera behind the character */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	USpringArmComponent* CameraBoom;
+
+	/** Follow camera */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	UCameraComponent* FollowCamera;
+
+	/** Distance the climb camera pulls the boom origin out of the climbed surface */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	float ClimbCameraSurfaceOffset{60.f};
+
+	/** Interpolation speed of the boom origin and arm length in and out of the climb camera */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	float ClimbCameraInterpSpeed{6.f};
+
+	/** Seconds between climb camera collision sweeps while the surface and the view are stable */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	float ClimbCameraProbeInterval{0.25f};
+
+	/** Change of the surface normal or the view that counts as unstable and sweeps right away (degrees) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	float ClimbCameraStableAngle{5.f};
+
+	/** Distance the boom origin may move from the last climb camera sweep before sweeping right away */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	float ClimbCameraStableDistance{20.f};
+
+	/** Custom Movement component*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
+	UCustomMovementComponent* CustomMovementComponent;
+	
+	/** MappingContext */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	UInputMappingContext* DefaultMappingContext;
+
+	/** Jump Input Action */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	UInputAction* JumpAction;
+
+	/** Move Input Action */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	UInputAction* MoveAction;
+
+	/** Called for jump input, hops, leaves or starts a wall run through the next move, jumps otherwise */
+	void OnJumpActionStarted(const FInputActionValue& Value);
+
+	/** Called for movement input */
+	void Move(const FInputActionValue& Value);
+
+	void HandleGroundMovementInput(const FInputActionValue& Value);
+
+	void HandleClimbMovementInput(const FInputActionValue& Value);
+
+	/** Look Input Action */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	UInputAction* LookAction;
+
+	/** Called for looking input */
+	void Look(const FInputActionValue& Value);
+
+	/** Climb Input Action */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	UInputAction* ClimbAction;
+
+	/** Called for Climbing Input */
+	void OnClimbActionStarted(const FInputActionValue& Value);
+
+	/** Runs the climb toggle on the server so it does not get corrected away */
+	UFUNCTION(Server, Reliable)
+	void ServerToggleClimbing(bool bEnableClimb);
+
+	/**
+	 * Climb camera mode of the locally controlled character
+	 *
+	 * Pulls the boom out along the climbed surface normal and replaces the per frame boom sweep
+	 * with one that only runs when the surface, the view or the boom origin changed, or every
+	 * ClimbCameraProbeInterval.
+	 */
+	void UpdateClimbCamera(float DeltaSeconds);
+
+	/** Length the boom could extend to at the last climb camera sweep */
+	float SweepClimbCameraArm() const;
+
+	bool bClimbCameraActive{false};
+
+	/** Boom length outside of the climb camera, restored when leaving it */
+	float DefaultCameraArmLength{0.f};
+
+	float ClimbCameraArmLength{0.f};
+
+	float ClimbCameraProbeTimer{0.f};
+
+	/** Surface normal, view and boom origin at the last climb camera sweep */
+	FVector ClimbCameraProbeNormal{FVector::ZeroVector};
+
+	FQuat ClimbCameraProbeRotation{FQuat::Identity};
+
+	FVector ClimbCameraProbeOrigin{FVector::ZeroVector};
+
+protected:
+	// APawn interface
+	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
+	
+	// To add mapping context
+	virtual void BeginPlay();
+
+	virtual void Tick(float DeltaSeconds) override;
+
+public:
+	/** Toggles climbing locally and on the server */
+	void RequestToggleClimbing(bool bEnableClimb);
+
+	/** Feeds a movement input vector through the same path as the Move action */
+	void AddMoveInput(const FVector2D& MovementVector);
+
+	/** Returns CameraBoom subobject **/
+	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
+	/** Returns FollowCamera subobject **/
+	FORCEINLINE class UCameraComponent* GetFollowCamera() const { return FollowCamera; }
+	/** Return CustomMovement subobject */
+	FORCEINLINE UCustomMovementComponent* GetCustomMovement() const { return CustomMovementComponent; }
+};
+
@@ -1,15 +1,33 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "ClimbingSystemGameMode.h"
-#include "ClimbingSystemCharacter.h"
-#include "UObject/ConstructorHelpers.h"
-
-AClimbingSystemGameMode::AClimbingSystemGameMode()
-{
-	// set default pawn class to our Blueprinted character
-	static ConstructorHelpers::FClassFinder<APawn> PlayerPawnBPClass(TEXT("/Game/ThirdPerson/Blueprints/BP_ThirdPersonCharacter"));
-	if (PlayerPawnBPClass.Class != NULL)
-	{
-		DefaultPawnClass = PlayerPawnBPClass.Class;
-	}
-}
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingSystemGameMode.h"
+#include "ClimbingSystemCharacter.h"
+#include "ClimbingMoverPawn.h"
+#include "UObject/ConstructorHelpers.h"
+
+static TAutoConsoleVariable<int32> CVarClimbMovementBackend(
+	TEXT("climb.MovementBackend"),
+	0,
+	TEXT("Movement backend of newly spawned players. 0: UCustomMovementComponent, 1: Mover."));
+
+AClimbingSystemGameMode::AClimbingSystemGameMode()
+{
+	// set default pawn class to our Blueprinted character
+	static ConstructorHelpers::FClassFinder<APawn> PlayerPawnBPClass(TEXT("/Game/ThirdPerson/Blueprints/BP_ThirdPersonCharacter"));
+	if (PlayerPawnBPClass.Class != NULL)
+	{
+		DefaultPawnClass = PlayerPawnBPClass.Class;
+	}
+
+	MoverPawnClass = AClimbingMoverPawn::StaticClass();
+}
+
+UClass* AClimbingSystemGameMode::GetDefaultPawnClassForController_Implementation(AController* InController)
+{
+	if (CVarClimbMovementBackend.GetValueOnGameThread() == 1 && MoverPawnClass)
+	{
+		return MoverPawnClass;
+	}
+
+	return Super::GetDefaultPawnClassForController_Implementation(InController);
+}
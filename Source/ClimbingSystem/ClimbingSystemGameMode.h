@@ -1,19 +1,26 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/GameModeBase.h"
-#include "ClimbingSystemGameMode.generated.h"
-
-UCLASS(minimalapi)
-class AClimbingSystemGameMode : public AGameModeBase
-{
-	GENERATED_BODY()
-
-public:
-	AClimbingSystemGameMode();
-};
-
-
-
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameModeBase.h"
+#include "ClimbingSystemGameMode.generated.h"
+
+UCLASS(minimalapi)
+class AClimbingSystemGameMode : public AGameModeBase
+{
+	GENERATED_BODY()
+
+public:
+	AClimbingSystemGameMode();
+
+	virtual UClass* GetDefaultPawnClassForController_Implementation(AController* InController) override;
+
+protected:
+	/** Pawn spawned instead of DefaultPawnClass when climb.MovementBackend selects Mover */
+	UPROPERTY(EditDefaultsOnly, Category = Classes)
+	TSubclassOf<APawn> MoverPawnClass;
+};
+
+
+
@@ -1,66 +1,153 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-
-#include "AnimInstance/CharacterAnimInstance.h"
-#include "ClimbingSystem/ClimbingSystemCharacter.h"
-#include "CustomMovementComponent.h"
-#include "Kismet/KismetMathLibrary.h"
-
-void UCharacterAnimInstance::NativeInitializeAnimation()
-{
-    Super::NativeInitializeAnimation();
-
-    ClimbingSystemCharacter = Cast<AClimbingSystemCharacter>(TryGetPawnOwner());
-    if (ClimbingSystemCharacter)
-    {
-        CustomMovementComponent = ClimbingSystemCharacter->GetCustomMovement();
-    }
-}
-
-void UCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
-{
-    Super::NativeUpdateAnimation(DeltaSeconds);
-
-    if (!ClimbingSystemCharacter || !CustomMovementComponent) return;
-
-    SetGroundSpeed();
-    SetAirSpeed();
-    SetShouldMove();
-    SetIsFalling();
-    SetIsClimbing();
-    SetClimbVelocity();
-}
-
-void UCharacterAnimInstance::SetGroundSpeed()
-{
-    GroundSpeed = UKismetMathLibrary::VSizeXY(
-        ClimbingSystemCharacter->GetVelocity());
-}
-
-void UCharacterAnimInstance::SetAirSpeed()
-{
-    AirSpeed = ClimbingSystemCharacter->GetVelocity().Z;
-}
-
-void UCharacterAnimInstance::SetShouldMove()
-{
-    bShouldMove = 
-        CustomMovementComponent->GetCurrentAcceleration().Size() > 0 &&
-        GroundSpeed > 5.f &&
-        !bIsFalling;
-}
-
-void UCharacterAnimInstance::SetIsFalling()
-{
-    bIsFalling = CustomMovementComponent->IsFalling();
-}
-
-void UCharacterAnimInstance::SetIsClimbing()
-{
-    bIsClimbing = CustomMovementComponent->IsClimbing();
-}
-
-void UCharacterAnimInstance::SetClimbVelocity()
-{
-    ClimbVelocity = CustomMovementComponent->GetUnrotatedClimbVelocity();
-}
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AnimInstance/CharacterAnimInstance.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "CustomMovementComponent.h"
+#include "ClimbingSystemStats.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Kismet/KismetMathLibrary.h"
+
+void UCharacterAnimInstance::NativeInitializeAnimation()
+{
+    Super::NativeInitializeAnimation();
+
+    ClimbingSystemCharacter = Cast<AClimbingSystemCharacter>(TryGetPawnOwner());
+    if (ClimbingSystemCharacter)
+    {
+        CustomMovementComponent = ClimbingSystemCharacter->GetCustomMovement();
+    }
+}
+
+void UCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
+{
+    Super::NativeUpdateAnimation(DeltaSeconds);
+
+    if (!ClimbingSystemCharacter || !CustomMovementComponent) return;
+
+    SetGroundSpeed();
+    SetAirSpeed();
+    SetShouldMove();
+    SetIsFalling();
+    SetIsWallRunning();
+    SetIsLedgeHanging();
+    SetIsClimbing();
+    SetClimbVelocity();
+    UpdateClimbIK(DeltaSeconds);
+}
+
+void UCharacterAnimInstance::SetGroundSpeed()
+{
+    GroundSpeed = UKismetMathLibrary::VSizeXY(
+        ClimbingSystemCharacter->GetVelocity());
+}
+
+void UCharacterAnimInstance::SetAirSpeed()
+{
+    AirSpeed = ClimbingSystemCharacter->GetVelocity().Z;
+}
+
+void UCharacterAnimInstance::SetShouldMove()
+{
+    bShouldMove = 
+        CustomMovementComponent->GetCurrentAcceleration().Size() > 0 &&
+        GroundSpeed > 5.f &&
+        !bIsFalling;
+}
+
+void UCharacterAnimInstance::SetIsFalling()
+{
+    bIsFalling = CustomMovementComponent->IsFalling();
+}
+
+void UCharacterAnimInstance::SetIsClimbing()
+{
+    // Hanging and hopping keep the climb pose, wall runs have their own
+    bIsClimbing = CustomMovementComponent->IsInClimbTraversal() && !bIsWallRunning;
+}
+
+void UCharacterAnimInstance::SetIsLedgeHanging()
+{
+    bIsLedgeHanging = CustomMovementComponent->IsLedgeHanging();
+}
+
+void UCharacterAnimInstance::SetIsWallRunning()
+{
+    bIsWallRunning = CustomMovementComponent->IsWallRunning();
+}
+
+void UCharacterAnimInstance::SetClimbVelocity()
+{
+    ClimbVelocity = CustomMovementComponent->GetUnrotatedClimbVelocity();
+}
+
+#pragma region ClimbIK
+void UCharacterAnimInstance::UpdateClimbIK(float DeltaSeconds)
+{
+    const FClimbSurfacePatch& Patch{CustomMovementComponent->GetClimbSurfacePatch()};
+    const bool bUseClimbIK{bIsClimbing && Patch.IsValid() && !IsAnyMontagePlaying()};
+
+    ClimbIKAlpha = FMath::FInterpTo(ClimbIKAlpha, bUseClimbIK ? 1.f : 0.f, DeltaSeconds, ClimbIKInterpSpeed);
+    if (!bUseClimbIK) return;
+
+    const USkeletalMeshComponent* Mesh{GetOwningComponent()};
+    const FName Bones[]{LeftHandBone, RightHandBone, LeftFootBone, RightFootBone};
+    FVector* const IKLocations[]{&LeftHandIKLocation, &RightHandIKLocation, &LeftFootIKLocation, &RightFootIKLocation};
+    constexpr int32 NumLimbs{UE_ARRAY_COUNT(Bones)};
+
+    FVector BoneLocations[NumLimbs];
+    FVector Targets[NumLimbs];
+    FVector Normals[NumLimbs];
+    bool bProjected[NumLimbs]{};
+
+    // Bounds of the limbs the probe did not cover, in the surface's right and up axes
+    const FQuat SurfaceRotation{FRotationMatrix::MakeFromXZ(-Patch.Normal, FVector::UpVector).ToQuat()};
+    FBox2D OutsideBounds(ForceInit);
+
+    for (int32 Limb = 0; Limb < NumLimbs; ++Limb)
+    {
+        BoneLocations[Limb] = Mesh->GetSocketLocation(Bones[Limb]);
+        bProjected[Limb] = Patch.ProjectPoint(BoneLocations[Limb], Targets[Limb], Normals[Limb]);
+
+        if (!bProjected[Limb])
+        {
+            const FVector LocalOffset{SurfaceRotation.UnrotateVector(BoneLocations[Limb] - Patch.Location)};
+            OutsideBounds += FVector2D(LocalOffset.Y, LocalOffset.Z);
+        }
+    }
+
+    if (OutsideBounds.bIsValid)
+    {
+        // One thin box swept into the wall covers every limb the probe missed
+        const FVector2D Center{OutsideBounds.GetCenter()};
+        const FVector2D Extent{OutsideBounds.GetExtent() + FVector2D(ClimbIKSurfaceOffset)};
+        const FVector SweepCenter{Patch.Location + SurfaceRotation.RotateVector(FVector(0.f, Center.X, Center.Y))};
+        const FVector SweepStart{SweepCenter + Patch.Normal * ClimbIKReach};
+        const FVector SweepEnd{SweepCenter - Patch.Normal * ClimbIKReach};
+
+        CustomMovementComponent->SweepClimbableSurfaces(SweepStart, SweepEnd, SurfaceRotation,
+            FCollisionShape::MakeBox(FVector(1.f, Extent.X, Extent.Y)), ClimbIKSweepSamples);
+
+        INC_DWORD_STAT(STAT_ClimbIKQueries);
+
+        for (int32 Limb = 0; Limb < NumLimbs; ++Limb)
+        {
+            if (!bProjected[Limb])
+            {
+                bProjected[Limb] = FClimbSurfacePatch::ProjectPointOntoSamples(ClimbIKSweepSamples, BoneLocations[Limb],
+                    Targets[Limb], Normals[Limb]);
+            }
+        }
+    }
+
+    for (int32 Limb = 0; Limb < NumLimbs; ++Limb)
+    {
+        // Limbs reaching into thin air keep their animated location
+        const FVector Target{bProjected[Limb] ? Targets[Limb] + Normals[Limb] * ClimbIKSurfaceOffset : BoneLocations[Limb]};
+
+        FVector& IKLocation{*IKLocations[Limb]};
+        IKLocation = ClimbIKAlpha < UE_KINDA_SMALL_NUMBER ? Target :
+            FMath::VInterpTo(IKLocation, Target, DeltaSeconds, ClimbIKInterpSpeed);
+    }
+}
+#pragma endregion
@@ -0,0 +1,272 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbAIController.h"
+#include "ClimbNavGraph.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "CustomMovementComponent.h"
+#include "NavigationPath.h"
+#include "NavigationSystem.h"
+#include "Navigation/PathFollowingComponent.h"
+
+AClimbAIController::AClimbAIController(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    PrimaryActorTick.bCanEverTick = true;
+}
+
+void AClimbAIController::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    switch (MoveState)
+    {
+    case EClimbMoveState::WaitingForGraph:
+        FollowClimbRoute();
+        break;
+
+    case EClimbMoveState::Climbing:
+        UpdateClimbing(DeltaSeconds);
+        break;
+
+    default:
+        break;
+    }
+}
+
+bool AClimbAIController::MoveToLocationWithClimbing(const FVector& Goal)
+{
+    AClimbingSystemCharacter* ClimbingCharacter{GetClimbingCharacter()};
+    if (!ClimbingCharacter || !ClimbingCharacter->GetCustomMovement()) return false;
+
+    GoalLocation = Goal;
+    ClimbPath.Reset();
+
+    const FVector Start{ClimbingCharacter->GetNavAgentLocation()};
+
+    // Plain walking whenever the navmesh gets all the way there
+    const UNavigationSystemV1* NavSys{FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld())};
+    const UNavigationPath* NavPath{NavSys ? UNavigationSystemV1::FindPathToLocationSynchronously(this, Start, Goal, ClimbingCharacter) : nullptr};
+
+    if (NavPath && NavPath->IsValid() && !NavPath->IsPartial())
+    {
+        MoveState = EClimbMoveState::Walking;
+        return MoveToLocation(Goal) != EPathFollowingRequestResult::Failed;
+    }
+
+    if (UClimbNavGraphSubsystem* ClimbNavGraph = GetWorld()->GetSubsystem<UClimbNavGraphSubsystem>())
+    {
+        const UCustomMovementComponent* CustomMovement{ClimbingCharacter->GetCustomMovement()};
+        ClimbNavGraph->SetClimbableObjectTypes(CustomMovement->GetClimbableSurfaceTraceTypes(), CustomMovement->UsesClimbableTraceChannel());
+    }
+
+    return FollowClimbRoute();
+}
+
+bool AClimbAIController::FollowClimbRoute()
+{
+    const AClimbingSystemCharacter* ClimbingCharacter{GetClimbingCharacter()};
+    UClimbNavGraphSubsystem* ClimbNavGraph{GetWorld()->GetSubsystem<UClimbNavGraphSubsystem>()};
+
+    if (!ClimbingCharacter || !ClimbNavGraph)
+    {
+        MoveState = EClimbMoveState::Idle;
+        return false;
+    }
+
+    if (ClimbNavGraph->GetGraphVersion() == 0)
+    {
+        MoveState = EClimbMoveState::WaitingForGraph;
+        return true;
+    }
+
+    ClimbPath = ClimbNavGraph->FindPath(ClimbingCharacter->GetNavAgentLocation(), GoalLocation);
+    if (!ClimbPath.IsValid())
+    {
+        MoveState = EClimbMoveState::Idle;
+        return false;
+    }
+
+    ClimbPathIndex = 0;
+    AdvanceClimbPath();
+
+    return true;
+}
+
+void AClimbAIController::StopClimbMove()
+{
+    StopMovement();
+
+    if (MoveState == EClimbMoveState::Climbing)
+    {
+        AClimbingSystemCharacter* ClimbingCharacter{GetClimbingCharacter()};
+        if (ClimbingCharacter && ClimbingCharacter->GetCustomMovement()->IsInClimbTraversal())
+        {
+            ClimbingCharacter->RequestToggleClimbing(false);
+        }
+    }
+
+    MoveState = EClimbMoveState::Idle;
+    ClimbPath.Reset();
+}
+
+void AClimbAIController::OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result)
+{
+    Super::OnMoveCompleted(RequestID, Result);
+
+    if (MoveState != EClimbMoveState::Walking) return;
+
+    if (!Result.IsSuccess() || !ClimbPath.IsValid())
+    {
+        MoveState = EClimbMoveState::Idle;
+        ClimbPath.Reset();
+        return;
+    }
+
+    ++ClimbPathIndex;
+    AdvanceClimbPath();
+}
+
+void AClimbAIController::AdvanceClimbPath()
+{
+    BestDistanceToPoint = TNumericLimits<float>::Max();
+    StuckTimer = 0.f;
+    ClimbRequestTimer = 0.f;
+
+    // Route used up, walk the rest of the way
+    if (!ClimbPath.IsValid() || !ClimbPath->Points.IsValidIndex(ClimbPathIndex))
+    {
+        ClimbPath.Reset();
+        MoveState = EClimbMoveState::Walking;
+        MoveToLocation(GoalLocation);
+        return;
+    }
+
+    const AClimbingSystemCharacter* ClimbingCharacter{GetClimbingCharacter()};
+    const FClimbNavPathPoint& Point{ClimbPath->Points[ClimbPathIndex]};
+
+    // Climb points, and any point while still on the wall, are handled by UpdateClimbing
+    if (Point.Type == EClimbNavNodeType::Climb || ClimbingCharacter->GetCustomMovement()->IsInClimbTraversal())
+    {
+        StopMovement();
+        MoveState = EClimbMoveState::Climbing;
+        return;
+    }
+
+    MoveState = EClimbMoveState::Walking;
+    if (MoveToLocation(Point.Location, ClimbAcceptanceRadius) == EPathFollowingRequestResult::AlreadyAtGoal)
+    {
+        ++ClimbPathIndex;
+        AdvanceClimbPath();
+    }
+}
+
+void AClimbAIController::UpdateClimbing(float DeltaSeconds)
+{
+    AClimbingSystemCharacter* ClimbingCharacter{GetClimbingCharacter()};
+    if (!ClimbingCharacter || !ClimbPath.IsValid())
+    {
+        StopClimbMove();
+        return;
+    }
+
+    const UCustomMovementComponent* CustomMovement{ClimbingCharacter->GetCustomMovement()};
+    const FClimbNavPathPoint& Point{ClimbPath->Points[ClimbPathIndex]};
+    const float DistanceToPoint{static_cast<float>(FVector::Dist(ClimbingCharacter->GetActorLocation(), Point.Location))};
+
+    // Give up when no progress is made, the route is stale or the wall cannot be grabbed
+    if (DistanceToPoint < BestDistanceToPoint - 10.f)
+    {
+        BestDistanceToPoint = DistanceToPoint;
+        StuckTimer = 0.f;
+    }
+    else if ((StuckTimer += DeltaSeconds) >= ClimbStuckTime)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("%s: climb move to %s got stuck"), *GetNameSafe(this), *GoalLocation.ToString());
+        StopClimbMove();
+        return;
+    }
+
+    const bool bOnWall{CustomMovement->IsInClimbTraversal()};
+    const bool bInTransition{ClimbingCharacter->GetCurrentMontage() != nullptr};
+
+    switch (Point.Type)
+    {
+    case EClimbNavNodeType::Climb:
+        if (bOnWall)
+        {
+            if (DistanceToPoint <= ClimbAcceptanceRadius)
+            {
+                ++ClimbPathIndex;
+                AdvanceClimbPath();
+                return;
+            }
+
+            ClimbingCharacter->AddMoveInput(GetClimbInputTowards(Point.Location));
+        }
+        else if (!bInTransition && !CustomMovement->HasPendingClimbIntent() && (ClimbRequestTimer -= DeltaSeconds) <= 0.f)
+        {
+            ClimbRequestTimer = ClimbRequestInterval;
+
+            // Into the wall from below, away from it when climbing down from the top
+            const FVector WallNormal{FVector(Point.Normal).GetSafeNormal2D()};
+            const bool bAboveWall{ClimbingCharacter->GetActorLocation().Z > Point.Location.Z + ClimbingCharacter->GetDefaultHalfHeight()};
+
+            ClimbingCharacter->SetActorRotation((bAboveWall ? WallNormal : -WallNormal).Rotation());
+            ClimbingCharacter->RequestToggleClimbing(true);
+        }
+        break;
+
+    case EClimbNavNodeType::Ledge:
+        // Climbing up to the ledge mantles on its own, done once back on the ground
+        if (bOnWall)
+        {
+            ClimbingCharacter->AddMoveInput(FVector2D(0.f, 1.f));
+        }
+        else if (!bInTransition && CustomMovement->IsMovingOnGround())
+        {
+            ++ClimbPathIndex;
+            AdvanceClimbPath();
+        }
+        break;
+
+    case EClimbNavNodeType::Ground:
+        // Let go once close to the floor and carry on after landing
+        if (bOnWall)
+        {
+            if (DistanceToPoint <= ClimbingCharacter->GetDefaultHalfHeight() * 2.f)
+            {
+                ClimbingCharacter->RequestToggleClimbing(false);
+            }
+            else
+            {
+                ClimbingCharacter->AddMoveInput(GetClimbInputTowards(Point.Location));
+            }
+        }
+        else if (CustomMovement->IsMovingOnGround())
+        {
+            ++ClimbPathIndex;
+            AdvanceClimbPath();
+        }
+        break;
+    }
+}
+
+FVector2D AClimbAIController::GetClimbInputTowards(const FVector& Target) const
+{
+    const AClimbingSystemCharacter* ClimbingCharacter{GetClimbingCharacter()};
+    const FVector SurfaceNormal{ClimbingCharacter->GetCustomMovement()->GetClimbableSurfaceNormal()};
+
+    // Same axes as AClimbingSystemCharacter::HandleClimbMovementInput
+    const FVector ClimbUp{FVector::CrossProduct(-SurfaceNormal, ClimbingCharacter->GetActorRightVector())};
+    const FVector ClimbRight{FVector::CrossProduct(-SurfaceNormal, -ClimbingCharacter->GetActorUpVector())};
+
+    const FVector ToTarget{Target - ClimbingCharacter->GetActorLocation()};
+
+    return FVector2D(FVector::DotProduct(ToTarget, ClimbRight), FVector::DotProduct(ToTarget, ClimbUp)).GetSafeNormal();
+}
+
+AClimbingSystemCharacter* AClimbAIController::GetClimbingCharacter() const
+{
+    return Cast<AClimbingSystemCharacter>(GetPawn());
+}
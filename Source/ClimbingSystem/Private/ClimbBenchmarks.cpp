@@ -0,0 +1,588 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// Console microbenchmarks for the climbing system, run them from the console or with -ExecCmds
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Math/RandomStream.h"
+#include "Containers/Ticker.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "ClimbingMoverPawn.h"
+#include "ClimbNavGraph.h"
+#include "ClimbingSystemCollision.h"
+#include "CustomMovementComponent.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace ClimbBenchmarks
+{
+    // Typical capsule probe hit count, each one used to re-derive the local velocity
+    static constexpr int32 FloorProbeHits{4};
+
+    // Local velocity reads per climb update before the frame cache: the floor check before and
+    // inside its hit loop, the ledge check and the anim instance
+    static constexpr int32 FloorCheckReads{1};
+    static constexpr int32 LedgeCheckReads{1};
+    static constexpr int32 AnimInstanceReads{1};
+    static constexpr int32 VelocityReadsPerUpdate{FloorCheckReads + FloorProbeHits + LedgeCheckReads + AnimInstanceReads};
+
+    static void RunClimbFrameBenchmark(const TArray<FString>& Args)
+    {
+        const int32 NumUpdates{Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100000};
+
+        FRandomStream Random(0x5eed);
+
+        TArray<FQuat> Rotations;
+        TArray<FVector> Velocities;
+        TArray<FVector> Normals;
+        Rotations.Reserve(NumUpdates);
+        Velocities.Reserve(NumUpdates);
+        Normals.Reserve(NumUpdates);
+
+        for (int32 Index = 0; Index < NumUpdates; ++Index)
+        {
+            Rotations.Add(FRotator(0.f, Random.FRandRange(-180.f, 180.f), 0.f).Quaternion());
+            Velocities.Add(Random.GetUnitVector() * 100.f);
+            Normals.Add((Random.GetUnitVector() * FVector(1.f, 1.f, 0.3f)).GetSafeNormal());
+        }
+
+        // Keeps the optimizer from discarding the math
+        double Sink{0.0};
+
+        // Every consumer derives its own rotation, angle and local velocity
+        const double LegacyStart{FPlatformTime::Seconds()};
+        for (int32 Index = 0; Index < NumUpdates; ++Index)
+        {
+            const FQuat TargetQuat{FRotationMatrix::MakeFromX(-Normals[Index]).ToQuat()};
+            Sink += TargetQuat.X;
+
+            Sink += FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(Normals[Index], FVector::UpVector)));
+
+            for (int32 Consumer = 0; Consumer < VelocityReadsPerUpdate; ++Consumer)
+            {
+                Sink += UKismetMathLibrary::Quat_UnrotateVector(Rotations[Index], Velocities[Index]).Z;
+            }
+        }
+        const double LegacySeconds{FPlatformTime::Seconds() - LegacyStart};
+
+        // One cached frame per update, consumers read it
+        const double CachedStart{FPlatformTime::Seconds()};
+        for (int32 Index = 0; Index < NumUpdates; ++Index)
+        {
+            const FQuat SurfaceRotation{FRotationMatrix::MakeFromX(-Normals[Index]).ToQuat()};
+            const float SurfaceUpDot{static_cast<float>(Normals[Index].Z)};
+            const FVector UnrotatedVelocity{Rotations[Index].UnrotateVector(Velocities[Index])};
+
+            Sink += SurfaceRotation.X;
+            Sink += SurfaceUpDot >= 0.5f;
+
+            for (int32 Consumer = 0; Consumer < VelocityReadsPerUpdate; ++Consumer)
+            {
+                Sink += UnrotatedVelocity.Z;
+            }
+        }
+        const double CachedSeconds{FPlatformTime::Seconds() - CachedStart};
+
+        UE_LOG(LogTemp, Log, TEXT("climb.Bench.ClimbFrame: %d updates, per-consumer math %.3f ms, cached frame %.3f ms (%.2fx) [%f]"),
+            NumUpdates,
+            LegacySeconds * 1000.0,
+            CachedSeconds * 1000.0,
+            CachedSeconds > 0.0 ? LegacySeconds / CachedSeconds : 0.0,
+            Sink);
+    }
+
+    static FAutoConsoleCommand ClimbFrameBenchmarkCommand(
+        TEXT("climb.Bench.ClimbFrame"),
+        TEXT("Times per-consumer climb rotation math against the cached climb frame. Usage: climb.Bench.ClimbFrame [Updates]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunClimbFrameBenchmark));
+
+    /**
+     * Spawns a wall far from the level and times the world tick with N climbers on it, once per
+     * movement backend. Runs over several frames from the core ticker, which owns the run until
+     * Tick returns false.
+     */
+    class FClimbBackendBenchmark : public TSharedFromThis<FClimbBackendBenchmark>
+    {
+    public:
+        FClimbBackendBenchmark(UWorld* InWorld, int32 InNumClimbers, float InMeasureSeconds)
+            : World(InWorld)
+            , NumClimbers(InNumClimbers)
+            , MeasureSeconds(InMeasureSeconds)
+        {
+        }
+
+        void Start()
+        {
+            TickStartHandle = FWorldDelegates::OnWorldTickStart.AddSP(this, &FClimbBackendBenchmark::OnWorldTickStart);
+            PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddSP(this, &FClimbBackendBenchmark::OnWorldPostActorTick);
+
+            // Delegates above only hold weak references, the ticker lambda keeps the run alive
+            FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+                [Self = AsShared()](float DeltaTime) { return Self->Tick(DeltaTime); }));
+        }
+
+    private:
+        enum class EPhase : uint8
+        {
+            Spawn,
+            Settle,
+            Warmup,
+            Measure
+        };
+
+        // Out of the way of the level, climbers spawn on a floor in front of the wall
+        static constexpr float ArenaHeight{50000.f};
+        static constexpr float ClimberSpacing{150.f};
+
+        bool Tick(float DeltaTime)
+        {
+            if (!World.IsValid())
+            {
+                Finish();
+                return false;
+            }
+
+            PhaseTime += DeltaTime;
+
+            switch (Phase)
+            {
+            case EPhase::Spawn:
+                SpawnArena();
+                SpawnClimbers();
+                EnterPhase(EPhase::Settle);
+                break;
+
+            case EPhase::Settle:
+                // Let everyone land before grabbing the wall
+                if (PhaseTime >= 0.5f)
+                {
+                    StartClimbing();
+                    EnterPhase(EPhase::Warmup);
+                }
+                break;
+
+            case EPhase::Warmup:
+                if (PhaseTime >= 1.f)
+                {
+                    NumClimbingAtStart[Backend] = CountClimbing();
+                    if (NumClimbingAtStart[Backend] == 0)
+                    {
+                        // Timing climbers that never reached the wall would only measure walking
+                        UE_LOG(LogTemp, Error, TEXT("climb.Bench.Backends: no %s climber got onto the wall, aborting"),
+                            BackendNames[Backend]);
+                        bAborted = true;
+                        Finish();
+                        return false;
+                    }
+                    TickSeconds[Backend] = 0.0;
+                    NumTicks[Backend] = 0;
+                    EnterPhase(EPhase::Measure);
+                }
+                break;
+
+            case EPhase::Measure:
+                if (PhaseTime >= MeasureSeconds)
+                {
+                    DestroyClimbers();
+
+                    if (++Backend == NumBackends)
+                    {
+                        Finish();
+                        return false;
+                    }
+                    EnterPhase(EPhase::Spawn);
+                }
+                break;
+            }
+
+            return true;
+        }
+
+        void EnterPhase(EPhase NewPhase)
+        {
+            Phase = NewPhase;
+            PhaseTime = 0.f;
+        }
+
+        void OnWorldTickStart(UWorld* TickedWorld, ELevelTick TickType, float DeltaTime)
+        {
+            if (TickedWorld == World.Get())
+            {
+                TickStartTime = FPlatformTime::Seconds();
+            }
+        }
+
+        void OnWorldPostActorTick(UWorld* TickedWorld, ELevelTick TickType, float DeltaTime)
+        {
+            if (TickedWorld != World.Get() || Phase != EPhase::Measure) return;
+
+            TickSeconds[Backend] += FPlatformTime::Seconds() - TickStartTime;
+            ++NumTicks[Backend];
+        }
+
+        FVector GetClimberLocation(int32 Index) const
+        {
+            const float Width{NumClimbers * ClimberSpacing};
+            return FVector(-110.f, Index * ClimberSpacing - Width * 0.5f, ArenaHeight + 100.f);
+        }
+
+        void SpawnArena()
+        {
+            if (Wall.IsValid()) return;
+
+            UStaticMesh* CubeMesh{LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"))};
+            const float WidthScale{NumClimbers * ClimberSpacing / 100.f + 2.f};
+
+            auto SpawnBlock = [this, CubeMesh](const FVector& Location, const FVector& Scale)
+            {
+                AStaticMeshActor* Block{World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator)};
+                // Spawned static mesh actors are Static and refuse a new mesh once registered
+                UStaticMeshComponent* MeshComponent{Block->GetStaticMeshComponent()};
+                MeshComponent->SetMobility(EComponentMobility::Movable);
+                if (!MeshComponent->SetStaticMesh(CubeMesh))
+                {
+                    UE_LOG(LogTemp, Error, TEXT("climb.Bench.Backends: could not give %s its mesh"), *Block->GetName());
+                }
+                Block->SetActorScale3D(Scale);
+                return Block;
+            };
+
+            // Cube is 100 units wide and centered, the wall face ends up at X = -50
+            Wall = SpawnBlock(FVector(0.f, 0.f, ArenaHeight + 1500.f), FVector(1.f, WidthScale, 30.f));
+            Floor = SpawnBlock(FVector(-1000.f, 0.f, ArenaHeight - 50.f), FVector(20.f, WidthScale, 1.f));
+        }
+
+        void SpawnClimbers()
+        {
+            UClass* PawnClass{AClimbingMoverPawn::StaticClass()};
+
+            if (Backend == 0)
+            {
+                // Prefer the configured blueprint, it carries the climb trace types and montages
+                const AGameModeBase* GameMode{World->GetAuthGameMode()};
+                PawnClass = GameMode && GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf<AClimbingSystemCharacter>() ?
+                    GameMode->DefaultPawnClass.Get() : AClimbingSystemCharacter::StaticClass();
+            }
+
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+            for (int32 Index = 0; Index < NumClimbers; ++Index)
+            {
+                APawn* Climber{World->SpawnActor<APawn>(PawnClass, GetClimberLocation(Index), FRotator::ZeroRotator, SpawnParams)};
+                if (!Climber) continue;
+
+                Climber->SpawnDefaultController();
+                Climbers.Add(Climber);
+            }
+        }
+
+        void StartClimbing()
+        {
+            for (const TWeakObjectPtr<APawn>& Climber : Climbers)
+            {
+                if (AClimbingSystemCharacter* Character = Cast<AClimbingSystemCharacter>(Climber.Get()))
+                {
+                    Character->RequestToggleClimbing(true);
+                }
+                else if (AClimbingMoverPawn* MoverPawn = Cast<AClimbingMoverPawn>(Climber.Get()))
+                {
+                    MoverPawn->RequestToggleClimbing(true);
+                }
+            }
+        }
+
+        int32 CountClimbing() const
+        {
+            int32 NumClimbing{0};
+            for (const TWeakObjectPtr<APawn>& Climber : Climbers)
+            {
+                if (const AClimbingSystemCharacter* Character = Cast<AClimbingSystemCharacter>(Climber.Get()))
+                {
+                    NumClimbing += Character->GetCustomMovement() && Character->GetCustomMovement()->IsClimbing();
+                }
+                else if (const AClimbingMoverPawn* MoverPawn = Cast<AClimbingMoverPawn>(Climber.Get()))
+                {
+                    NumClimbing += MoverPawn->IsClimbing();
+                }
+            }
+            return NumClimbing;
+        }
+
+        void DestroyClimbers()
+        {
+            for (const TWeakObjectPtr<APawn>& Climber : Climbers)
+            {
+                if (!Climber.IsValid()) continue;
+
+                if (AController* Controller = Climber->GetController())
+                {
+                    Controller->Destroy();
+                }
+                Climber->Destroy();
+            }
+            Climbers.Reset();
+        }
+
+        void Finish()
+        {
+            DestroyClimbers();
+
+            if (Wall.IsValid()) Wall->Destroy();
+            if (Floor.IsValid()) Floor->Destroy();
+
+            FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+            FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+            if (bAborted) return;
+
+            for (int32 Index = 0; Index < NumBackends; ++Index)
+            {
+                UE_LOG(LogTemp, Log, TEXT("climb.Bench.Backends: %-17s %d climbers (%d climbing), world tick %.3f ms avg over %d ticks"),
+                    BackendNames[Index],
+                    NumClimbers,
+                    NumClimbingAtStart[Index],
+                    NumTicks[Index] > 0 ? TickSeconds[Index] / NumTicks[Index] * 1000.0 : 0.0,
+                    NumTicks[Index]);
+            }
+        }
+
+        static constexpr int32 NumBackends{2};
+        static constexpr const TCHAR* BackendNames[NumBackends]{TEXT("CharacterMovement"), TEXT("Mover")};
+
+        TWeakObjectPtr<UWorld> World;
+        int32 NumClimbers;
+        float MeasureSeconds;
+
+        int32 Backend{0};
+        EPhase Phase{EPhase::Spawn};
+        float PhaseTime{0.f};
+        bool bAborted{false};
+
+        TWeakObjectPtr<AActor> Wall;
+        TWeakObjectPtr<AActor> Floor;
+        TArray<TWeakObjectPtr<APawn>> Climbers;
+
+        FDelegateHandle TickStartHandle;
+        FDelegateHandle PostActorTickHandle;
+        double TickStartTime{0.0};
+
+        double TickSeconds[NumBackends]{};
+        int32 NumTicks[NumBackends]{};
+        int32 NumClimbingAtStart[NumBackends]{};
+    };
+
+    static void RunBackendBenchmark(const TArray<FString>& Args, UWorld* World)
+    {
+        if (!World || !World->IsGameWorld())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("climb.Bench.Backends needs a game world"));
+            return;
+        }
+
+        const int32 NumClimbers{Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 128};
+        const float MeasureSeconds{Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 1.f) : 5.f};
+
+        MakeShared<FClimbBackendBenchmark>(World, NumClimbers, MeasureSeconds)->Start();
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs BackendBenchmarkCommand(
+        TEXT("climb.Bench.Backends"),
+        TEXT("Times the world tick with climbers on UCustomMovementComponent and on Mover. Usage: climb.Bench.Backends [Climbers=128] [Seconds=5]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunBackendBenchmark));
+
+    static void RunNavPathBenchmark(const TArray<FString>& Args, UWorld* World)
+    {
+        UClimbNavGraphSubsystem* ClimbNavGraph{World ? World->GetSubsystem<UClimbNavGraphSubsystem>() : nullptr};
+        if (!ClimbNavGraph || ClimbNavGraph->GetGraphVersion() == 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("climb.Bench.NavPaths needs a built climb nav graph, move an AI climber first"));
+            return;
+        }
+
+        const FClimbNavGraph& Graph{ClimbNavGraph->GetGraph()};
+
+        TArray<int32> Endpoints;
+        for (int32 Index = 0; Index < Graph.GetNodes().Num(); ++Index)
+        {
+            if (Graph.GetNodes()[Index].IsEndpoint())
+            {
+                Endpoints.Add(Index);
+            }
+        }
+
+        if (Endpoints.Num() < 2)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("climb.Bench.NavPaths: the graph has fewer than two endpoints"));
+            return;
+        }
+
+        const int32 NumQueries{Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000};
+        const int32 NumDistinctPairs{Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 64};
+
+        // Agents re-planning mostly ask for the same few routes, model that with a small pair pool
+        FRandomStream Random(0x5eed);
+        TArray<TPair<int32, int32>> Pairs;
+        for (int32 Index = 0; Index < NumDistinctPairs; ++Index)
+        {
+            Pairs.Emplace(Endpoints[Random.RandHelper(Endpoints.Num())], Endpoints[Random.RandHelper(Endpoints.Num())]);
+        }
+
+        TArray<int32> PathNodes;
+        float PathCost{0.f};
+        int32 NumFound{0};
+
+        const double SearchStart{FPlatformTime::Seconds()};
+        for (int32 Index = 0; Index < NumQueries; ++Index)
+        {
+            const TPair<int32, int32>& Pair{Pairs[Index % Pairs.Num()]};
+            NumFound += Graph.FindPath(Pair.Key, Pair.Value, PathNodes, PathCost);
+        }
+        const double SearchSeconds{FPlatformTime::Seconds() - SearchStart};
+
+        // Same queries through the subsystem, endpoint lookup and cache included
+        const double CachedStart{FPlatformTime::Seconds()};
+        for (int32 Index = 0; Index < NumQueries; ++Index)
+        {
+            const TPair<int32, int32>& Pair{Pairs[Index % Pairs.Num()]};
+            ClimbNavGraph->FindPath(Graph.GetNodes()[Pair.Key].Location, Graph.GetNodes()[Pair.Value].Location);
+        }
+        const double CachedSeconds{FPlatformTime::Seconds() - CachedStart};
+
+        UE_LOG(LogTemp, Log, TEXT("climb.Bench.NavPaths: %d nodes, %d queries over %d pairs (%d found), A* %.2f us/query, cached %.2f us/query"),
+            Graph.GetNodes().Num(),
+            NumQueries,
+            Pairs.Num(),
+            NumFound,
+            SearchSeconds * 1.e6 / NumQueries,
+            CachedSeconds * 1.e6 / NumQueries);
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs NavPathBenchmarkCommand(
+        TEXT("climb.Bench.NavPaths"),
+        TEXT("Times climb graph path queries, raw A* and through the path cache. Usage: climb.Bench.NavPaths [Queries=1000] [Pairs=64]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunNavPathBenchmark));
+
+    static void RunClimbableChannelBenchmark(const TArray<FString>& Args, UWorld* World)
+    {
+        if (!World) return;
+
+        const int32 NumClutter{Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 5000};
+        const int32 NumQueries{Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 10000};
+
+        // Dense block of small props with a few climbable walls in it, far above the level
+        constexpr float ArenaHeight{60000.f};
+        const float ArenaExtent{FMath::Sqrt(static_cast<float>(NumClutter)) * 150.f};
+
+        UStaticMesh* CubeMesh{LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"))};
+        FRandomStream Random(0x5eed);
+        TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+
+        auto SpawnBlock = [World, CubeMesh, &SpawnedActors](const FVector& Location, const FVector& Scale, FName ProfileName)
+        {
+            AStaticMeshActor* Block{World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator)};
+            UStaticMeshComponent* MeshComponent{Block->GetStaticMeshComponent()};
+            MeshComponent->SetMobility(EComponentMobility::Movable);
+            MeshComponent->SetStaticMesh(CubeMesh);
+            MeshComponent->SetCollisionProfileName(ProfileName);
+            Block->SetActorScale3D(Scale);
+            SpawnedActors.Add(Block);
+        };
+
+        for (int32 Index = 0; Index < NumClutter; ++Index)
+        {
+            const FVector Location{Random.FRandRange(-ArenaExtent, ArenaExtent), Random.FRandRange(-ArenaExtent, ArenaExtent),
+                ArenaHeight + Random.FRandRange(0.f, 300.f)};
+            SpawnBlock(Location, FVector(Random.FRandRange(0.2f, 0.6f)), UCollisionProfile::BlockAll_ProfileName);
+        }
+
+        for (int32 Index = 0; Index < FMath::Max(NumClutter / 100, 1); ++Index)
+        {
+            const FVector Location{Random.FRandRange(-ArenaExtent, ArenaExtent), Random.FRandRange(-ArenaExtent, ArenaExtent), ArenaHeight + 500.f};
+            SpawnBlock(Location, FVector(1.f, 5.f, 10.f), ClimbingSystemCollision::ClimbableProfileName);
+        }
+
+        TArray<FVector> QueryLocations;
+        QueryLocations.Reserve(NumQueries);
+        for (int32 Index = 0; Index < NumQueries; ++Index)
+        {
+            QueryLocations.Emplace(Random.FRandRange(-ArenaExtent, ArenaExtent), Random.FRandRange(-ArenaExtent, ArenaExtent),
+                ArenaHeight + Random.FRandRange(0.f, 500.f));
+        }
+
+        // Give the physics scene a few frames to take the new bodies into its acceleration structure
+        FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+            [WeakWorld = TWeakObjectPtr<UWorld>(World), SpawnedActors, QueryLocations](float)
+            {
+                UWorld* BenchWorld{WeakWorld.Get()};
+                if (!BenchWorld) return false;
+
+                // Same shape and direction as the climb surface probe
+                const FCollisionShape ProbeShape{FCollisionShape::MakeCapsule(50.f, 72.f)};
+                const FCollisionQueryParams QueryParams{SCENE_QUERY_STAT(ClimbBenchChannel), false};
+                const FCollisionObjectQueryParams ObjectParams{TArray<TEnumAsByte<EObjectTypeQuery>>{
+                    UEngineTypes::ConvertToObjectType(ECC_WorldStatic), UEngineTypes::ConvertToObjectType(ECC_WorldDynamic)}};
+
+                TArray<FHitResult> Hits;
+                int64 NumObjectHits{0};
+                int64 NumChannelHits{0};
+
+                const double ObjectStart{FPlatformTime::Seconds()};
+                for (const FVector& Location : QueryLocations)
+                {
+                    BenchWorld->SweepMultiByObjectType(Hits, Location, Location + FVector::ForwardVector, FQuat::Identity,
+                        ObjectParams, ProbeShape, QueryParams);
+                    NumObjectHits += Hits.Num();
+                }
+                const double ObjectSeconds{FPlatformTime::Seconds() - ObjectStart};
+
+                const double ChannelStart{FPlatformTime::Seconds()};
+                for (const FVector& Location : QueryLocations)
+                {
+                    BenchWorld->SweepMultiByChannel(Hits, Location, Location + FVector::ForwardVector, FQuat::Identity,
+                        ECC_Climbable, ProbeShape, QueryParams, FCollisionResponseParams(ECR_Overlap));
+                    NumChannelHits += Hits.Num();
+                }
+                const double ChannelSeconds{FPlatformTime::Seconds() - ChannelStart};
+
+                const int32 NumLocations{QueryLocations.Num()};
+                UE_LOG(LogTemp, Log, TEXT("climb.Bench.ClimbableChannel: %d actors, %d queries, object types %.2f us/query (%.2f hits), ")
+                    TEXT("Climbable channel %.2f us/query (%.2f hits)"),
+                    SpawnedActors.Num(),
+                    NumLocations,
+                    ObjectSeconds * 1.e6 / NumLocations,
+                    static_cast<double>(NumObjectHits) / NumLocations,
+                    ChannelSeconds * 1.e6 / NumLocations,
+                    static_cast<double>(NumChannelHits) / NumLocations);
+
+                if (NumObjectHits == 0)
+                {
+                    UE_LOG(LogTemp, Error, TEXT("climb.Bench.ClimbableChannel: the object type sweeps hit nothing, the arena has no geometry and the timings are meaningless"));
+                }
+
+                for (const TWeakObjectPtr<AActor>& Actor : SpawnedActors)
+                {
+                    if (Actor.IsValid())
+                    {
+                        Actor->Destroy();
+                    }
+                }
+
+                return false;
+            }), 0.1f);
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs ClimbableChannelBenchmarkCommand(
+        TEXT("climb.Bench.ClimbableChannel"),
+        TEXT("Times climb probe sweeps by object type against the Climbable channel in a dense test arena. ")
+        TEXT("Usage: climb.Bench.ClimbableChannel [Clutter=5000] [Queries=10000]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunClimbableChannelBenchmark));
+}
+
+#endif
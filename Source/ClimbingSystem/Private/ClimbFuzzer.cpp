@@ -0,0 +1,560 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Algo/Count.h"
+#include "Containers/Ticker.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/GameModeBase.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "CustomMovementComponent.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace ClimbFuzzer
+{
+    /** Pathological geometry the climb solver is known to struggle with */
+    enum class ECourseType : uint8
+    {
+        /** Two walls meeting at a random angle, climbers start inside the corner */
+        ConcaveCorner,
+        /** Outside edge of a box, the probe sees both faces */
+        ConvexEdge,
+        /** Vertical cylinder thinner than the probe capsule */
+        ThinPole,
+        /** Wall leaning over the climbers */
+        Overhang,
+        /** Slope within a degree of the stop angle of CheckShouldStopClimbing */
+        CutoffSlope,
+        /** Wall covered in small randomly rotated blocks */
+        Jagged,
+        Num
+    };
+
+    static const TCHAR* GetCourseTypeName(ECourseType Type)
+    {
+        static const TCHAR* Names[]{TEXT("ConcaveCorner"), TEXT("ConvexEdge"), TEXT("ThinPole"), TEXT("Overhang"),
+            TEXT("CutoffSlope"), TEXT("Jagged")};
+        static_assert(UE_ARRAY_COUNT(Names) == static_cast<int32>(ECourseType::Num));
+
+        return Names[static_cast<int32>(Type)];
+    }
+
+    /** Script directions fed to the climbers, as AClimbingSystemCharacter::AddMoveInput expects them */
+    static const FVector2D ScriptInputs[]{{0.f, 1.f}, {1.f, 0.f}, {0.f, -1.f}, {-1.f, 0.f}, {0.7f, 0.7f}, {-0.7f, 0.7f}};
+
+    struct FClimberRun
+    {
+        TWeakObjectPtr<AClimbingSystemCharacter> Character;
+
+        FVector2D Input{FVector2D::ZeroVector};
+
+        uint32 LastTraversalChanges{0};
+
+        /** Course time of the last observed mode change */
+        float LastChangeTime{-1.f};
+
+        float ClimbRequestTimer{0.f};
+
+        /** Movement over the current stuck detection window */
+        FVector WindowStartLocation{FVector::ZeroVector};
+
+        float WindowTime{0.f};
+
+        bool bClimbedWholeWindow{true};
+    };
+
+    struct FCourseReport
+    {
+        int32 Seed{0};
+
+        ECourseType Type{ECourseType::ConcaveCorner};
+
+        /** Angle, radius or lean of the course, depends on Type */
+        float Parameter{0.f};
+
+        int32 NumModeChanges{0};
+
+        /** Mode changes less than RapidFlapTime after the previous one */
+        int32 NumRapidFlaps{0};
+
+        int32 NumNaNFrames{0};
+
+        /** Frames in climb traversal with a zero surface normal */
+        int32 NumZeroNormalFrames{0};
+
+        float StuckSeconds{0.f};
+
+        float ClimbSeconds{0.f};
+
+        TArray<float> FrameMs;
+
+        int32 NumCostOutliers{0};
+
+        float MedianFrameMs{0.f};
+
+        float MaxFrameMs{0.f};
+
+        /** A block of the course could not be given its mesh, the course was not run */
+        bool bMissingGeometry{false};
+
+        bool IsFlagged() const
+        {
+            return bMissingGeometry || NumRapidFlaps > 0 || NumNaNFrames > 0 || NumZeroNormalFrames > 0 || StuckSeconds > 0.f || NumCostOutliers > 0;
+        }
+    };
+
+    /**
+     * Builds random pathological courses far from the level and runs scripted climbers over them,
+     * one course at a time so frame cost can be attributed. Runs headless from the core ticker,
+     * which owns the run until Tick returns false.
+     */
+    class FClimbFuzzRun : public TSharedFromThis<FClimbFuzzRun>
+    {
+    public:
+        FClimbFuzzRun(UWorld* InWorld, int32 InNumCourses, int32 InSeed, float InCourseSeconds)
+            : World(InWorld)
+            , NumCourses(InNumCourses)
+            , BaseSeed(InSeed)
+            , CourseSeconds(InCourseSeconds)
+        {
+        }
+
+        void Start()
+        {
+            TickStartHandle = FWorldDelegates::OnWorldTickStart.AddSP(this, &FClimbFuzzRun::OnWorldTickStart);
+            PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddSP(this, &FClimbFuzzRun::OnWorldPostActorTick);
+
+            // Delegates above only hold weak references, the ticker lambda keeps the run alive
+            FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+                [Self = AsShared()](float DeltaTime) { return Self->Tick(DeltaTime); }));
+        }
+
+    private:
+        static constexpr float ArenaHeight{70000.f};
+        static constexpr int32 ClimbersPerCourse{3};
+        static constexpr float SettleSeconds{0.5f};
+        static constexpr float ScriptStepSeconds{1.5f};
+        static constexpr float ClimbRequestInterval{1.f};
+        static constexpr float RapidFlapTime{0.25f};
+        static constexpr float StuckWindowSeconds{1.f};
+        static constexpr float StuckDistance{2.f};
+        static constexpr float CostOutlierFactor{4.f};
+        static constexpr float CostOutlierFloorMs{1.f};
+
+        bool Tick(float DeltaTime)
+        {
+            if (!World.IsValid())
+            {
+                Finish();
+                return false;
+            }
+
+            if (!bCourseRunning)
+            {
+                if (Reports.Num() == NumCourses)
+                {
+                    Finish();
+                    return false;
+                }
+
+                BuildCourse(BaseSeed + Reports.Num());
+                return true;
+            }
+
+            CourseTime += DeltaTime;
+            if (CourseTime >= SettleSeconds)
+            {
+                UpdateClimbers(DeltaTime);
+            }
+
+            if (CourseTime >= SettleSeconds + CourseSeconds)
+            {
+                FinishCourse();
+            }
+
+            return true;
+        }
+
+        void OnWorldTickStart(UWorld* TickedWorld, ELevelTick TickType, float DeltaTime)
+        {
+            if (TickedWorld == World.Get())
+            {
+                TickStartTime = FPlatformTime::Seconds();
+            }
+        }
+
+        void OnWorldPostActorTick(UWorld* TickedWorld, ELevelTick TickType, float DeltaTime)
+        {
+            if (TickedWorld != World.Get() || !bCourseRunning || CourseTime < SettleSeconds) return;
+
+            Reports.Last().FrameMs.Add(static_cast<float>((FPlatformTime::Seconds() - TickStartTime) * 1000.0));
+        }
+
+        AStaticMeshActor* SpawnBlock(UStaticMesh* Mesh, const FVector& Location, const FRotator& Rotation, const FVector& Scale)
+        {
+            AStaticMeshActor* Block{World->SpawnActor<AStaticMeshActor>(CourseOrigin + Location, Rotation)};
+
+            // Static components refuse a new mesh once the world has begun play
+            UStaticMeshComponent* MeshComponent{Block->GetStaticMeshComponent()};
+            MeshComponent->SetMobility(EComponentMobility::Movable);
+            if (!MeshComponent->SetStaticMesh(Mesh))
+            {
+                Reports.Last().bMissingGeometry = true;
+            }
+
+            Block->SetActorScale3D(Scale);
+            CourseActors.Add(Block);
+            return Block;
+        }
+
+        /** Box whose face facing Normal passes through FacePoint */
+        void SpawnWall(const FVector& FacePoint, const FVector& Normal, float Width, float Height, float Thickness = 50.f)
+        {
+            // The cube is 100 units wide and centered, its -X face becomes the climbable one
+            const FRotator Rotation{FRotationMatrix::MakeFromXZ(-Normal, FVector::UpVector).Rotator()};
+            SpawnBlock(CubeMesh, FacePoint - Normal * Thickness * 0.5f, Rotation, FVector(Thickness, Width, Height) / 100.f);
+        }
+
+        void BuildCourse(int32 Seed)
+        {
+            CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+            UStaticMesh* CylinderMesh{LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cylinder.Cylinder"))};
+
+            FRandomStream Random(Seed);
+            FCourseReport& Report{Reports.AddDefaulted_GetRef()};
+            Report.Seed = Seed;
+            Report.Type = static_cast<ECourseType>(Random.RandHelper(static_cast<int32>(ECourseType::Num)));
+
+            // Every course gets its own spot so leftovers of the previous one cannot interfere
+            CourseOrigin = FVector(Reports.Num() * 3000.f, 0.f, ArenaHeight);
+
+            // Floor with its top at the course origin, features start at X = 0 in front of the climbers
+            SpawnBlock(CubeMesh, FVector(0.f, 0.f, -50.f), FRotator::ZeroRotator, FVector(15.f, 15.f, 1.f));
+
+            switch (Report.Type)
+            {
+            case ECourseType::ConcaveCorner:
+            {
+                Report.Parameter = Random.FRandRange(40.f, 160.f);
+                const float HalfAngle{FMath::DegreesToRadians(Report.Parameter * 0.5f)};
+
+                // Both walls run from the corner line towards the climbers, normals point into the corner
+                for (const float Side : {1.f, -1.f})
+                {
+                    const FVector Along{-FMath::Cos(HalfAngle), Side * FMath::Sin(HalfAngle), 0.f};
+                    const FVector Normal{FVector::CrossProduct(FVector::UpVector, Along) * Side};
+                    SpawnWall(FVector(150.f, 0.f, 400.f) + Along * 200.f, Normal, 400.f, 800.f);
+                }
+                break;
+            }
+
+            case ECourseType::ConvexEdge:
+            {
+                // Square block turned so one of its vertical edges points at the climbers, give or take
+                Report.Parameter = Random.FRandRange(-20.f, 20.f);
+                SpawnBlock(CubeMesh, FVector(212.f, 0.f, 400.f), FRotator(0.f, 45.f + Report.Parameter, 0.f), FVector(3.f, 3.f, 8.f));
+                break;
+            }
+
+            case ECourseType::ThinPole:
+            {
+                Report.Parameter = Random.FRandRange(4.f, 40.f);
+                SpawnBlock(CylinderMesh, FVector(Report.Parameter * 0.5f, 0.f, 400.f), FRotator::ZeroRotator,
+                    FVector(Report.Parameter / 100.f, Report.Parameter / 100.f, 8.f));
+                break;
+            }
+
+            case ECourseType::Overhang:
+            {
+                Report.Parameter = Random.FRandRange(5.f, 50.f);
+                const float Lean{FMath::DegreesToRadians(Report.Parameter)};
+                const FVector Normal{-FMath::Cos(Lean), 0.f, -FMath::Sin(Lean)};
+
+                // Vertical base the climbers grab, with the overhang starting on top of it
+                SpawnWall(FVector(0.f, 0.f, 125.f), -FVector::ForwardVector, 600.f, 250.f);
+
+                const FVector Up{FVector::CrossProduct(Normal, FVector::RightVector) * -1.f};
+                SpawnWall(FVector(0.f, 0.f, 250.f) + Up * 300.f, Normal, 600.f, 600.f);
+                break;
+            }
+
+            case ECourseType::CutoffSlope:
+            {
+                // Angle between the surface normal and world up, right around the stop angle
+                Report.Parameter = 60.f + Random.FRandRange(-1.f, 1.f);
+                const float NormalAngle{FMath::DegreesToRadians(Report.Parameter)};
+                const FVector Normal{-FMath::Sin(NormalAngle), 0.f, FMath::Cos(NormalAngle)};
+
+                const FVector Up{FVector::CrossProduct(Normal, FVector::RightVector) * -1.f};
+                SpawnWall(Up * 400.f, Normal, 600.f, 800.f);
+                break;
+            }
+
+            case ECourseType::Jagged:
+            {
+                Report.Parameter = static_cast<float>(Random.RandRange(6, 16));
+                SpawnWall(FVector(0.f, 0.f, 400.f), -FVector::ForwardVector, 600.f, 800.f);
+
+                for (int32 Index = 0; Index < static_cast<int32>(Report.Parameter); ++Index)
+                {
+                    const FVector Location{Random.FRandRange(-20.f, 10.f), Random.FRandRange(-250.f, 250.f), Random.FRandRange(50.f, 600.f)};
+                    const FRotator Rotation{Random.FRandRange(-60.f, 60.f), Random.FRandRange(-60.f, 60.f), Random.FRandRange(-60.f, 60.f)};
+                    SpawnBlock(CubeMesh, Location, Rotation, FVector(Random.FRandRange(0.2f, 0.8f)));
+                }
+                break;
+            }
+
+            default:
+                break;
+            }
+
+            if (Report.bMissingGeometry)
+            {
+                UE_LOG(LogTemp, Error, TEXT("climb.Fuzz: FLAGGED seed %d %s could not be built, skipped"),
+                    Report.Seed, GetCourseTypeName(Report.Type));
+                ClearCourse();
+                return;
+            }
+
+            SpawnClimbers();
+
+            CourseTime = 0.f;
+            bCourseRunning = true;
+        }
+
+        void SpawnClimbers()
+        {
+            // Prefer the configured blueprint, it carries the climb trace types and montages
+            const AGameModeBase* GameMode{World->GetAuthGameMode()};
+            UClass* CharacterClass{GameMode && GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf<AClimbingSystemCharacter>() ?
+                GameMode->DefaultPawnClass.Get() : AClimbingSystemCharacter::StaticClass()};
+
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+            for (int32 Index = 0; Index < ClimbersPerCourse; ++Index)
+            {
+                const FVector Location{CourseOrigin + FVector(-60.f, (Index - ClimbersPerCourse / 2) * 120.f, 100.f)};
+
+                AClimbingSystemCharacter* Character{World->SpawnActor<AClimbingSystemCharacter>(CharacterClass, Location,
+                    FRotator::ZeroRotator, SpawnParams)};
+                if (!Character || !Character->GetCustomMovement()) continue;
+
+                Character->SpawnDefaultController();
+
+                FClimberRun& Run{Climbers.AddDefaulted_GetRef()};
+                Run.Character = Character;
+                Run.LastTraversalChanges = Character->GetCustomMovement()->GetNumClimbTraversalChanges();
+                Run.WindowStartLocation = Character->GetActorLocation();
+            }
+        }
+
+        void UpdateClimbers(float DeltaTime)
+        {
+            FCourseReport& Report{Reports.Last()};
+            const float ScriptTime{CourseTime - SettleSeconds};
+            const int32 ScriptStep{FMath::FloorToInt32(ScriptTime / ScriptStepSeconds)};
+
+            for (int32 Index = 0; Index < Climbers.Num(); ++Index)
+            {
+                FClimberRun& Run{Climbers[Index]};
+                AClimbingSystemCharacter* Character{Run.Character.Get()};
+                if (!Character) continue;
+
+                const UCustomMovementComponent* CustomMovement{Character->GetCustomMovement()};
+                const bool bInTraversal{CustomMovement->IsInClimbTraversal()};
+
+                // Mode changes observed since the last tick, several in one tick are flaps by definition
+                const uint32 TraversalChanges{CustomMovement->GetNumClimbTraversalChanges()};
+                const int32 NewChanges{static_cast<int32>(TraversalChanges - Run.LastTraversalChanges)};
+                if (NewChanges > 0)
+                {
+                    Report.NumModeChanges += NewChanges;
+
+                    const bool bRapid{NewChanges > 1 || (Run.LastChangeTime >= 0.f && CourseTime - Run.LastChangeTime < RapidFlapTime)};
+                    Report.NumRapidFlaps += bRapid ? NewChanges : 0;
+
+                    Run.LastChangeTime = CourseTime;
+                    Run.LastTraversalChanges = TraversalChanges;
+                }
+
+                const FVector SurfaceNormal{CustomMovement->GetClimbableSurfaceNormal()};
+                if (SurfaceNormal.ContainsNaN() || Character->GetActorLocation().ContainsNaN() || CustomMovement->Velocity.ContainsNaN())
+                {
+                    ++Report.NumNaNFrames;
+                }
+                else if (CustomMovement->IsClimbing() && SurfaceNormal.IsNearlyZero())
+                {
+                    ++Report.NumZeroNormalFrames;
+                }
+
+                if (bInTraversal)
+                {
+                    Report.ClimbSeconds += DeltaTime;
+
+                    // Each climber walks the script from its own step so the course sees several directions at once
+                    Run.Input = ScriptInputs[(ScriptStep + Index) % UE_ARRAY_COUNT(ScriptInputs)];
+                    Character->AddMoveInput(Run.Input);
+                }
+                else if ((Run.ClimbRequestTimer -= DeltaTime) <= 0.f)
+                {
+                    // Scripted re-grabs are rate limited so they never read as flapping
+                    Run.ClimbRequestTimer = ClimbRequestInterval;
+                    Character->RequestToggleClimbing(true);
+                }
+
+                UpdateStuckWindow(Run, Report, DeltaTime, bInTraversal);
+            }
+        }
+
+        void UpdateStuckWindow(FClimberRun& Run, FCourseReport& Report, float DeltaTime, bool bInTraversal)
+        {
+            const AClimbingSystemCharacter* Character{Run.Character.Get()};
+
+            Run.bClimbedWholeWindow &= bInTraversal && !Character->GetCurrentMontage();
+            Run.WindowTime += DeltaTime;
+
+            if (Run.WindowTime < StuckWindowSeconds) return;
+
+            // Pushing into the surface the whole window without going anywhere
+            if (Run.bClimbedWholeWindow &&
+                FVector::Dist(Character->GetActorLocation(), Run.WindowStartLocation) < StuckDistance)
+            {
+                Report.StuckSeconds += Run.WindowTime;
+            }
+
+            Run.WindowStartLocation = Character->GetActorLocation();
+            Run.WindowTime = 0.f;
+            Run.bClimbedWholeWindow = true;
+        }
+
+        void FinishCourse()
+        {
+            FCourseReport& Report{Reports.Last()};
+
+            if (!Report.FrameMs.IsEmpty())
+            {
+                TArray<float> SortedFrameMs{Report.FrameMs};
+                SortedFrameMs.Sort();
+
+                Report.MedianFrameMs = SortedFrameMs[SortedFrameMs.Num() / 2];
+                Report.MaxFrameMs = SortedFrameMs.Last();
+
+                const float OutlierMs{FMath::Max(Report.MedianFrameMs * CostOutlierFactor, Report.MedianFrameMs + CostOutlierFloorMs)};
+                Report.NumCostOutliers = Algo::CountIf(Report.FrameMs, [OutlierMs](float FrameMs) { return FrameMs > OutlierMs; });
+            }
+
+            UE_LOG(LogTemp, Log, TEXT("climb.Fuzz: %s seed %d %-13s param %6.1f | changes %3d rapid flaps %3d | NaN %d zero normal %d | ")
+                TEXT("stuck %.1fs climbing %.1fs | frame median %.2f ms max %.2f ms outliers %d"),
+                Report.IsFlagged() ? TEXT("FLAGGED") : TEXT("ok     "),
+                Report.Seed,
+                GetCourseTypeName(Report.Type),
+                Report.Parameter,
+                Report.NumModeChanges,
+                Report.NumRapidFlaps,
+                Report.NumNaNFrames,
+                Report.NumZeroNormalFrames,
+                Report.StuckSeconds,
+                Report.ClimbSeconds,
+                Report.MedianFrameMs,
+                Report.MaxFrameMs,
+                Report.NumCostOutliers);
+
+            ClearCourse();
+            bCourseRunning = false;
+        }
+
+        void ClearCourse()
+        {
+            for (const FClimberRun& Run : Climbers)
+            {
+                if (AClimbingSystemCharacter* Character = Run.Character.Get())
+                {
+                    if (AController* Controller = Character->GetController())
+                    {
+                        Controller->Destroy();
+                    }
+                    Character->Destroy();
+                }
+            }
+            Climbers.Reset();
+
+            for (const TWeakObjectPtr<AActor>& Actor : CourseActors)
+            {
+                if (Actor.IsValid())
+                {
+                    Actor->Destroy();
+                }
+            }
+            CourseActors.Reset();
+        }
+
+        void Finish()
+        {
+            ClearCourse();
+
+            FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+            FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+            const int32 NumFlagged{static_cast<int32>(Algo::CountIf(Reports, [](const FCourseReport& Report) { return Report.IsFlagged(); }))};
+            UE_LOG(LogTemp, Log, TEXT("climb.Fuzz: %d of %d courses flagged, rerun one with climb.Fuzz.Run 1 <seed>"),
+                NumFlagged, Reports.Num());
+        }
+
+        TWeakObjectPtr<UWorld> World;
+
+        int32 NumCourses{0};
+
+        int32 BaseSeed{0};
+
+        float CourseSeconds{0.f};
+
+        UStaticMesh* CubeMesh{nullptr};
+
+        FVector CourseOrigin{FVector::ZeroVector};
+
+        bool bCourseRunning{false};
+
+        float CourseTime{0.f};
+
+        TArray<FClimberRun> Climbers;
+
+        TArray<TWeakObjectPtr<AActor>> CourseActors;
+
+        TArray<FCourseReport> Reports;
+
+        double TickStartTime{0.0};
+
+        FDelegateHandle TickStartHandle;
+
+        FDelegateHandle PostActorTickHandle;
+    };
+
+    static void RunFuzzer(const TArray<FString>& Args, UWorld* World)
+    {
+        if (!World) return;
+
+        const int32 NumCourses{Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 16};
+        const int32 Seed{Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 0};
+        const float CourseSeconds{Args.Num() > 2 ? FMath::Max(FCString::Atof(*Args[2]), 1.f) : 6.f};
+
+        UE_LOG(LogTemp, Log, TEXT("climb.Fuzz: running %d courses from seed %d, %.1f s each"), NumCourses, Seed, CourseSeconds);
+
+        MakeShared<FClimbFuzzRun>(World, NumCourses, Seed, CourseSeconds)->Start();
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs FuzzCommand(
+        TEXT("climb.Fuzz.Run"),
+        TEXT("Runs scripted climbers over procedurally generated corner, pole, overhang and cutoff slope courses and flags ")
+        TEXT("flapping, NaN or zero normals, stuck climbers and frame cost outliers. Usage: climb.Fuzz.Run [Courses=16] [Seed=0] [Seconds=6]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunFuzzer));
+}
+
+#endif
@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbLoadTestGameMode.h"
+#include "ClimbLoadTestPlayerController.h"
+#include "ClimbingReplicationGraph.h"
+#include "CustomMovementComponent.h"
+#include "GameFramework/Character.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "TimerManager.h"
+
+AClimbLoadTestGameMode::AClimbLoadTestGameMode()
+{
+    PlayerControllerClass = AClimbLoadTestPlayerController::StaticClass();
+}
+
+void AClimbLoadTestGameMode::BeginPlay()
+{
+    Super::BeginPlay();
+
+    FParse::Value(FCommandLine::Get(), TEXT("ClimbLoadTestReportInterval="), ReportInterval);
+    FParse::Value(FCommandLine::Get(), TEXT("ClimbLoadTestDuration="), Duration);
+
+    TickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &AClimbLoadTestGameMode::OnWorldTickStart);
+    PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &AClimbLoadTestGameMode::OnWorldPostActorTick);
+
+    GetWorldTimerManager().SetTimer(ReportTimerHandle, this, &AClimbLoadTestGameMode::ReportLoadTest,
+        FMath::Max(ReportInterval, 0.1f), true);
+
+    if (Duration > 0.f)
+    {
+        FTimerHandle ExitTimerHandle;
+        GetWorldTimerManager().SetTimer(ExitTimerHandle, FTimerDelegate::CreateWeakLambda(this, [this]()
+        {
+            ReportLoadTest();
+            UE_LOG(LogTemp, Display, TEXT("ClimbLoadTest: finished after %.0f s"), Duration);
+            FPlatformMisc::RequestExit(false);
+        }), Duration, false);
+    }
+}
+
+void AClimbLoadTestGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+    FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AClimbLoadTestGameMode::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaTime)
+{
+    if (World != GetWorld()) return;
+
+    TickStartTime = FPlatformTime::Seconds();
+}
+
+void AClimbLoadTestGameMode::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime)
+{
+    if (World != GetWorld() || TickStartTime <= 0.0) return;
+
+    const double TickSeconds{FPlatformTime::Seconds() - TickStartTime};
+    TickSecondsTotal += TickSeconds;
+    TickSecondsMax = FMath::Max(TickSecondsMax, TickSeconds);
+    ++NumTicks;
+}
+
+void AClimbLoadTestGameMode::ReportLoadTest()
+{
+    UE_LOG(LogTemp, Display, TEXT("ClimbLoadTest: %d players, world tick avg %.2f ms, max %.2f ms over %d ticks"),
+        GetNumPlayers(),
+        NumTicks > 0 ? TickSecondsTotal / NumTicks * 1000.0 : 0.0,
+        TickSecondsMax * 1000.0,
+        NumTicks);
+
+    TickSecondsTotal = 0.0;
+    TickSecondsMax = 0.0;
+    NumTicks = 0;
+
+    const UNetDriver* NetDriver{GetWorld()->GetNetDriver()};
+    if (UClimbingReplicationGraph* Graph = NetDriver ? Cast<UClimbingReplicationGraph>(NetDriver->GetReplicationDriver()) : nullptr)
+    {
+        int32 NumFrames{0};
+        const double ReplicateSeconds{Graph->ConsumeAverageReplicateSeconds(NumFrames)};
+
+        UE_LOG(LogTemp, Display, TEXT("ClimbLoadTest: replication (%s) avg %.3f ms over %d frames"),
+            Graph->GetClimbNode() ? TEXT("climb node") : TEXT("basic grid"), ReplicateSeconds * 1000.0, NumFrames);
+    }
+
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        APlayerController* PlayerController{It->Get()};
+        const UNetConnection* Connection{PlayerController ? PlayerController->GetNetConnection() : nullptr};
+        if (!Connection) continue;
+
+        const ACharacter* Character{PlayerController->GetCharacter()};
+        const UCustomMovementComponent* CustomMovement{Character ?
+            Cast<UCustomMovementComponent>(Character->GetCharacterMovement()) : nullptr};
+
+        const uint32 NumCorrections{CustomMovement ? CustomMovement->GetNumClientCorrections() : 0};
+        uint32& LastCorrections = LastReportedCorrections.FindOrAdd(PlayerController);
+
+        UE_LOG(LogTemp, Display, TEXT("ClimbLoadTest:   %-24s corrections %4u, out %6d B/s, in %6d B/s, climbing %d"),
+            *PlayerController->GetName(),
+            NumCorrections - LastCorrections,
+            Connection->OutBytesPerSecond,
+            Connection->InBytesPerSecond,
+            CustomMovement && CustomMovement->IsInClimbTraversal());
+
+        LastCorrections = NumCorrections;
+    }
+}
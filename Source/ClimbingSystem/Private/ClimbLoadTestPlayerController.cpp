@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbLoadTestPlayerController.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "CustomMovementComponent.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+AClimbLoadTestPlayerController::AClimbLoadTestPlayerController()
+{
+    PrimaryActorTick.bCanEverTick = true;
+}
+
+void AClimbLoadTestPlayerController::BeginPlay()
+{
+    Super::BeginPlay();
+
+    bIsClimbBot = IsLocalController() && FParse::Param(FCommandLine::Get(), TEXT("ClimbBot"));
+
+    int32 BotSeed{0};
+    FParse::Value(FCommandLine::Get(), TEXT("ClimbBotSeed="), BotSeed);
+    BotRandom.Initialize(BotSeed);
+
+    EnterState(EClimbBotState::Approach);
+}
+
+void AClimbLoadTestPlayerController::PlayerTick(float DeltaTime)
+{
+    Super::PlayerTick(DeltaTime);
+
+    if (!bIsClimbBot) return;
+
+    AClimbingSystemCharacter* ClimbingCharacter{GetClimbingCharacter()};
+    if (!ClimbingCharacter || !ClimbingCharacter->GetCustomMovement()) return;
+
+    const UCustomMovementComponent* CustomMovement{ClimbingCharacter->GetCustomMovement()};
+    StateTime += DeltaTime;
+
+    switch (BotState)
+    {
+    case EClimbBotState::Approach:
+        ClimbingCharacter->AddMoveInput(FVector2D(0.f, 1.f));
+
+        if (CustomMovement->IsClimbing())
+        {
+            EnterState(EClimbBotState::Climb);
+        }
+        else if (StateTime >= ApproachTime)
+        {
+            EnterState(EClimbBotState::Turn);
+        }
+        else if (StateTime >= NextClimbAttemptTime)
+        {
+            NextClimbAttemptTime = StateTime + ClimbAttemptInterval;
+            ClimbingCharacter->RequestToggleClimbing(true);
+        }
+        break;
+
+    case EClimbBotState::Climb:
+        // Reaching a ledge mantles on its own and drops the character out of climbing
+        ClimbingCharacter->AddMoveInput(FVector2D(0.f, 1.f));
+
+        if (!CustomMovement->IsInClimbTraversal())
+        {
+            EnterState(EClimbBotState::Turn);
+        }
+        else if (StateTime >= ClimbTime)
+        {
+            EnterState(EClimbBotState::Descend);
+        }
+        break;
+
+    case EClimbBotState::Descend:
+        ClimbingCharacter->AddMoveInput(FVector2D(0.f, -1.f));
+
+        if (!CustomMovement->IsInClimbTraversal())
+        {
+            EnterState(EClimbBotState::Turn);
+        }
+        else if (StateTime >= DescendTime)
+        {
+            ClimbingCharacter->RequestToggleClimbing(false);
+            EnterState(EClimbBotState::Turn);
+        }
+        break;
+
+    case EClimbBotState::Turn:
+        SetControlRotation(GetControlRotation() + FRotator(0.f, BotRandom.FRandRange(90.f, 270.f), 0.f));
+        EnterState(EClimbBotState::Approach);
+        break;
+    }
+}
+
+void AClimbLoadTestPlayerController::EnterState(EClimbBotState NewState)
+{
+    BotState = NewState;
+    StateTime = 0.f;
+    NextClimbAttemptTime = 0.f;
+}
+
+AClimbingSystemCharacter* AClimbLoadTestPlayerController::GetClimbingCharacter() const
+{
+    return Cast<AClimbingSystemCharacter>(GetPawn());
+}
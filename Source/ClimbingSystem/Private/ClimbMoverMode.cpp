@@ -0,0 +1,267 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbMoverMode.h"
+#include "ClimbSurfaceMath.h"
+#include "ClimbingSystemCollision.h"
+#include "ClimbingSystemStats.h"
+#include "MoverComponent.h"
+#include "Backends/MoverNetworkPhysicsLiaison.h"
+#include "MoverDataModelTypes.h"
+#include "MoverSimulationTypes.h"
+#include "MoveLibrary/MovementUtils.h"
+#include "Engine/World.h"
+
+FMoverDataStructBase* FClimbMoverInputs::Clone() const
+{
+    return new FClimbMoverInputs(*this);
+}
+
+bool FClimbMoverInputs::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    Super::NetSerialize(Ar, Map, bOutSuccess);
+
+    Ar.SerializeBits(&bIsClimbToggleJustPressed, 1);
+
+    bOutSuccess = true;
+    return true;
+}
+
+void FClimbMoverInputs::ToString(FAnsiStringBuilderBase& Out) const
+{
+    Super::ToString(Out);
+
+    Out.Appendf("bIsClimbToggleJustPressed: %i\n", bIsClimbToggleJustPressed);
+}
+
+const FName UClimbMoverMode::ModeName{TEXT("Climb")};
+const FName UClimbMoverMode::SurfaceBlackboardKey{TEXT("ClimbSurface")};
+
+UClimbMoverMode::UClimbMoverMode(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    ClimbableSurfaceTraceTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldStatic));
+    FallbackModeName = DefaultModeNames::Falling;
+}
+
+//~ Begin UBaseMovementMode Interface
+
+void UClimbMoverMode::OnGenerateMove(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep,
+    FProposedMove& OutProposedMove) const
+{
+    const FCharacterDefaultInputs* CharacterInputs{StartState.InputCmd.InputCollection.FindDataByType<FCharacterDefaultInputs>()};
+    const FMoverDefaultSyncState* StartingSyncState{StartState.SyncState.SyncStateCollection.FindDataByType<FMoverDefaultSyncState>()};
+    check(StartingSyncState);
+
+    FClimbSurfaceInfo Surface;
+    if (const UMoverBlackboard* SimBlackboard = GetMoverComponent()->GetSimBlackboard())
+    {
+        SimBlackboard->TryGet(SurfaceBlackboardKey, Surface);
+    }
+
+    OutProposedMove.LinearVelocity = FVector::ZeroVector;
+    if (!CharacterInputs || Surface.Normal.IsZero()) return;
+
+    // Same mapping as AClimbingSystemCharacter::HandleClimbMovementInput, stick forward climbs up
+    const FRotator ControlYaw{0.f, CharacterInputs->ControlRotation.Yaw, 0.f};
+    const FVector MoveInput{CharacterInputs->GetMoveInput()};
+    const float UpInput{static_cast<float>(FVector::DotProduct(MoveInput, ControlYaw.Vector()))};
+    const float RightInput{static_cast<float>(FVector::DotProduct(MoveInput, FRotationMatrix(ControlYaw).GetUnitAxis(EAxis::Y)))};
+
+    const FQuat Orientation{StartingSyncState->GetOrientation_WorldSpace().Quaternion()};
+    const FVector ClimbUp{FVector::CrossProduct(-Surface.Normal, Orientation.GetRightVector())};
+    const FVector ClimbRight{FVector::CrossProduct(-Surface.Normal, -Orientation.GetUpVector())};
+
+    OutProposedMove.LinearVelocity = (ClimbUp * UpInput + ClimbRight * RightInput).GetClampedToMaxSize(1.f) * MaxClimbSpeed;
+    OutProposedMove.DirectionIntent = OutProposedMove.LinearVelocity.GetSafeNormal();
+    OutProposedMove.bHasDirIntent = !OutProposedMove.DirectionIntent.IsZero();
+}
+
+void UClimbMoverMode::OnSimulationTick(const FSimulationTickParams& Params, FMoverTickEndData& OutputState)
+{
+    USceneComponent* UpdatedComponent{Params.MovingComps.UpdatedComponent.Get()};
+    UMoverBlackboard* SimBlackboard{Params.SimBlackboard};
+    const FMoverDefaultSyncState* StartingSyncState{Params.StartState.SyncState.SyncStateCollection.FindDataByType<FMoverDefaultSyncState>()};
+    check(StartingSyncState);
+
+    FMoverDefaultSyncState& OutputSyncState = OutputState.SyncState.SyncStateCollection.FindOrAddMutableDataByType<FMoverDefaultSyncState>();
+
+    const float DeltaSeconds{Params.TimeStep.StepMs * 0.001f};
+    if (!UpdatedComponent || DeltaSeconds <= UE_SMALL_NUMBER)
+    {
+        OutputSyncState = *StartingSyncState;
+        return;
+    }
+
+    FClimbSurfaceInfo PreviousSurface;
+    if (SimBlackboard)
+    {
+        SimBlackboard->TryGet(SurfaceBlackboardKey, PreviousSurface);
+    }
+
+    FClimbSurfaceInfo Surface{GetLatestSurface()};
+    Surface.Normal = ClimbSurfaceMath::SmoothNormal(PreviousSurface.Normal, Surface.Normal,
+        DeltaSeconds, ClimbSurfaceNormalSmoothingTime);
+
+    // Same stop rule as UCustomMovementComponent::CheckShouldStopClimbing
+    if (Surface.Normal.IsZero() || Surface.Normal.Z >= ClimbSurfaceMath::StopAngleCos)
+    {
+        if (SimBlackboard)
+        {
+            SimBlackboard->Invalidate(SurfaceBlackboardKey);
+        }
+
+        OutputSyncState = *StartingSyncState;
+        OutputState.MovementEndState.NextModeName = FallbackModeName;
+        OutputState.MovementEndState.RemainingMs = Params.TimeStep.StepMs;
+        return;
+    }
+
+    if (SimBlackboard)
+    {
+        SimBlackboard->Set(SurfaceBlackboardKey, Surface);
+    }
+
+    OutputState.MovementEndState.RemainingMs = 0.f;
+
+    // Read the start transform from the sync state, on the physics thread the component lags behind
+    const FVector StartLocation{StartingSyncState->GetLocation_WorldSpace()};
+    const FQuat StartRotation{StartingSyncState->GetOrientation_WorldSpace().Quaternion()};
+    const FQuat TargetRotation{FMath::QInterpTo(StartRotation,
+        ClimbSurfaceMath::GetSurfaceRotation(Surface.Normal, StartRotation), DeltaSeconds, 5.f)};
+
+    if (IsPhysicsDriven())
+    {
+        // The liaison moves the body towards this transform and resolves collision in the solver
+        const FVector SnapVelocity{ClimbSurfaceMath::GetSnapVector(Surface, StartLocation,
+            StartRotation.GetForwardVector()) * MaxClimbSpeed};
+        const FVector TargetVelocity{Params.ProposedMove.LinearVelocity + SnapVelocity};
+
+        OutputSyncState.SetTransforms_WorldSpace(
+            StartLocation + TargetVelocity * DeltaSeconds,
+            TargetRotation.Rotator(),
+            TargetVelocity,
+            nullptr);
+        return;
+    }
+
+    FMovementRecord MoveRecord;
+    MoveRecord.SetDeltaSeconds(DeltaSeconds);
+
+    const FVector MoveDelta{Params.ProposedMove.LinearVelocity * DeltaSeconds};
+    FHitResult Hit(1.f);
+
+    UMovementUtils::TrySafeMoveUpdatedComponent(Params.MovingComps, MoveDelta, TargetRotation, true, Hit,
+        ETeleportType::None, MoveRecord);
+
+    if (Hit.IsValidBlockingHit())
+    {
+        INC_DWORD_STAT(STAT_ClimbSlideIterations);
+
+        UMovementUtils::TryMoveToSlideAlongSurface(Params.MovingComps, MoveDelta, 1.f - Hit.Time, TargetRotation,
+            Hit.Normal, Hit, true, MoveRecord);
+    }
+
+    // Snap after the velocity is recorded, it is a correction and not movement
+    const FVector SnapVector{ClimbSurfaceMath::GetSnapVector(Surface, UpdatedComponent->GetComponentLocation(),
+        UpdatedComponent->GetForwardVector())};
+
+    FMovementRecord SnapRecord;
+    FHitResult SnapHit(1.f);
+    UMovementUtils::TrySafeMoveUpdatedComponent(Params.MovingComps, SnapVector * DeltaSeconds * MaxClimbSpeed,
+        UpdatedComponent->GetComponentQuat(), true, SnapHit, ETeleportType::None, SnapRecord);
+
+    OutputSyncState.SetTransforms_WorldSpace(
+        UpdatedComponent->GetComponentLocation(),
+        UpdatedComponent->GetComponentRotation(),
+        MoveRecord.GetRelevantVelocity(),
+        nullptr);
+}
+
+//~ End UBaseMovementMode Interface
+
+void UClimbMoverMode::RefreshSurface(const USceneComponent* UpdatedComponent)
+{
+    check(IsInGameThread());
+
+    const FClimbSurfaceInfo Surface{ProbeSurface(UpdatedComponent)};
+
+    FScopeLock Lock(&LatestSurfaceLock);
+    LatestSurface = Surface;
+}
+
+bool UClimbMoverMode::CanClimb() const
+{
+    const FClimbSurfaceInfo Surface{GetLatestSurface()};
+
+    return !Surface.Normal.IsZero() && Surface.Normal.Z < ClimbSurfaceMath::StopAngleCos;
+}
+
+FClimbSurfaceInfo UClimbMoverMode::GetLatestSurface() const
+{
+    FScopeLock Lock(&LatestSurfaceLock);
+    return LatestSurface;
+}
+
+bool UClimbMoverMode::IsPhysicsDriven() const
+{
+    const UMoverComponent* MoverComponent{GetMoverComponent()};
+
+    return MoverComponent && MoverComponent->BackendClass
+        && MoverComponent->BackendClass->IsChildOf(UMoverNetworkPhysicsLiaisonComponent::StaticClass());
+}
+
+FClimbSurfaceInfo UClimbMoverMode::ProbeSurface(const USceneComponent* UpdatedComponent) const
+{
+    const UWorld* World{UpdatedComponent ? UpdatedComponent->GetWorld() : nullptr};
+    if (!World) return FClimbSurfaceInfo();
+
+    // Mirrors UCustomMovementComponent::TraceClimbaleSurface
+    const FVector ProbeDirection{UpdatedComponent->GetForwardVector()};
+    const FVector Start{UpdatedComponent->GetComponentLocation() + ProbeDirection * 30.f};
+    const FVector End{Start + ProbeDirection};
+
+    FCollisionQueryParams QueryParams{SCENE_QUERY_STAT(ClimbMoverProbe), false, UpdatedComponent->GetOwner()};
+
+    TArray<FHitResult> Hits;
+    World->SweepMultiByObjectType(Hits, Start, End, FQuat::Identity,
+        FCollisionObjectQueryParams(ClimbableSurfaceTraceTypes),
+        FCollisionShape::MakeCapsule(ClimbCapsuleTraceRadius, ClimbCapsuleTraceHalfHeight),
+        QueryParams);
+
+    INC_DWORD_STAT(STAT_ClimbQueriesIssued);
+
+    TArray<FClimbSurfaceSample, TInlineAllocator<8>> Samples;
+    for (const FHitResult& Hit : Hits)
+    {
+        if (ClimbingSystemCollision::IsClimbableHit(Hit))
+        {
+            Samples.Add(FClimbSurfaceSample::FromHit(Hit));
+        }
+    }
+
+    return ClimbSurfaceMath::EstimateSurface(Samples, UpdatedComponent->GetComponentLocation(), ClimbSurfaceOutlierAngle);
+}
+
+FTransitionEvalResult UClimbMoverToggleTransition::OnEvaluate(const FSimulationTickParams& Params) const
+{
+    const FClimbMoverInputs* ClimbInputs{Params.StartState.InputCmd.InputCollection.FindDataByType<FClimbMoverInputs>()};
+    const UMoverComponent* MoverComponent{Params.MovingComps.MoverComponent.Get()};
+    if (!ClimbInputs || !ClimbInputs->bIsClimbToggleJustPressed || !MoverComponent)
+    {
+        return FTransitionEvalResult::NoTransition;
+    }
+
+    const UClimbMoverMode* ClimbMode{Cast<UClimbMoverMode>(MoverComponent->MovementModes.FindRef(UClimbMoverMode::ModeName))};
+    if (!ClimbMode)
+    {
+        return FTransitionEvalResult::NoTransition;
+    }
+
+    if (Params.StartState.SyncState.MovementMode == UClimbMoverMode::ModeName)
+    {
+        return FTransitionEvalResult(ClimbMode->FallbackModeName);
+    }
+
+    return ClimbMode->CanClimb() ? FTransitionEvalResult(UClimbMoverMode::ModeName) : FTransitionEvalResult::NoTransition;
+}
@@ -0,0 +1,622 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbNavGraph.h"
+#include "ClimbSurfaceMath.h"
+#include "ClimbingSystemStats.h"
+#include "ClimbingSystemCollision.h"
+#include "Algo/Reverse.h"
+#include "Components/PrimitiveComponent.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+
+#if ENABLE_DRAW_DEBUG
+static TAutoConsoleVariable<bool> CVarClimbNavDraw(
+    TEXT("climb.Nav.Draw"),
+    false,
+    TEXT("Draw the climb navigation graph around the first player."));
+#endif
+
+// Same as the default walkable floor angle of the character movement component
+static constexpr float WalkableFloorZ{0.71f};
+
+// Upper bound on samples along one side of a bounds face, keeps huge meshes from stalling a rebuild
+static constexpr int32 MaxSamplesPerAxis{64};
+
+void FClimbNavGraph::Reset()
+{
+    Nodes.Reset();
+    Edges.Reset();
+    PendingEdges.Reset();
+    Cells.Reset();
+    CostSoFar.Reset();
+    CameFrom.Reset();
+    SearchStamps.Reset();
+    SearchStamp = 0;
+}
+
+int32 FClimbNavGraph::AddNode(const FVector& Location, const FVector& Normal, EClimbNavNodeType Type)
+{
+    FClimbNavNode& Node{Nodes.AddDefaulted_GetRef()};
+    Node.Location = Location;
+    Node.Normal = FVector3f(Normal);
+    Node.Type = Type;
+
+    PendingEdges.AddDefaulted();
+
+    return Nodes.Num() - 1;
+}
+
+void FClimbNavGraph::AddEdge(int32 NodeA, int32 NodeB, float Cost)
+{
+    PendingEdges[NodeA].Add({NodeB, Cost});
+    PendingEdges[NodeB].Add({NodeA, Cost});
+}
+
+void FClimbNavGraph::Finalize(float InCellSize, float WalkLinkRadius)
+{
+    CellSize = FMath::Max(InCellSize, 1.f);
+
+    Cells.Reset();
+    for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+    {
+        Cells.FindOrAdd(GetCell(Nodes[Index].Location)).Add(Index);
+    }
+
+    // Endpoints close to each other are assumed to be connected by the navmesh
+    const int32 CellSpan{FMath::CeilToInt(WalkLinkRadius / CellSize)};
+    const float WalkLinkRadiusSquared{FMath::Square(WalkLinkRadius)};
+
+    for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+    {
+        const FClimbNavNode& Node{Nodes[Index]};
+        if (!Node.IsEndpoint()) continue;
+
+        const FIntVector Cell{GetCell(Node.Location)};
+        for (int32 X = -CellSpan; X <= CellSpan; ++X)
+        for (int32 Y = -CellSpan; Y <= CellSpan; ++Y)
+        for (int32 Z = -CellSpan; Z <= CellSpan; ++Z)
+        {
+            const TArray<int32>* CellNodes{Cells.Find(Cell + FIntVector(X, Y, Z))};
+            if (!CellNodes) continue;
+
+            for (const int32 Other : *CellNodes)
+            {
+                // Each pair once
+                if (Other <= Index || !Nodes[Other].IsEndpoint()) continue;
+
+                const float DistanceSquared{static_cast<float>(FVector::DistSquared(Node.Location, Nodes[Other].Location))};
+                if (DistanceSquared <= WalkLinkRadiusSquared)
+                {
+                    AddEdge(Index, Other, FMath::Sqrt(DistanceSquared));
+                }
+            }
+        }
+    }
+
+    // Pack the adjacency into one array
+    Edges.Reset();
+    for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+    {
+        Nodes[Index].FirstEdge = Edges.Num();
+        Nodes[Index].NumEdges = PendingEdges[Index].Num();
+        Edges.Append(PendingEdges[Index]);
+    }
+    PendingEdges.Empty();
+
+    CostSoFar.SetNumUninitialized(Nodes.Num());
+    CameFrom.SetNumUninitialized(Nodes.Num());
+    SearchStamps.Init(0, Nodes.Num());
+    SearchStamp = 0;
+}
+
+int32 FClimbNavGraph::FindNearestNode(const FVector& Location, float MaxDistance, bool bEndpointsOnly) const
+{
+    const FIntVector Cell{GetCell(Location)};
+    const int32 CellSpan{FMath::CeilToInt(MaxDistance / CellSize)};
+
+    int32 NearestNode{INDEX_NONE};
+    double NearestDistanceSquared{FMath::Square(MaxDistance)};
+
+    for (int32 X = -CellSpan; X <= CellSpan; ++X)
+    for (int32 Y = -CellSpan; Y <= CellSpan; ++Y)
+    for (int32 Z = -CellSpan; Z <= CellSpan; ++Z)
+    {
+        const TArray<int32>* CellNodes{Cells.Find(Cell + FIntVector(X, Y, Z))};
+        if (!CellNodes) continue;
+
+        for (const int32 Index : *CellNodes)
+        {
+            if (bEndpointsOnly && !Nodes[Index].IsEndpoint()) continue;
+
+            const double DistanceSquared{FVector::DistSquared(Location, Nodes[Index].Location)};
+            if (DistanceSquared < NearestDistanceSquared)
+            {
+                NearestDistanceSquared = DistanceSquared;
+                NearestNode = Index;
+            }
+        }
+    }
+
+    return NearestNode;
+}
+
+bool FClimbNavGraph::FindPath(int32 StartNode, int32 GoalNode, TArray<int32>& OutNodes, float& OutCost) const
+{
+    OutNodes.Reset();
+    OutCost = 0.f;
+
+    if (!Nodes.IsValidIndex(StartNode) || !Nodes.IsValidIndex(GoalNode)) return false;
+
+    // A new stamp invalidates the previous search, the arrays only get cleared when it wraps
+    if (++SearchStamp == 0)
+    {
+        SearchStamps.Init(0, Nodes.Num());
+        SearchStamp = 1;
+    }
+
+    struct FOpenNode
+    {
+        float Priority;
+        float Cost;
+        int32 Node;
+    };
+
+    auto ByPriority = [](const FOpenNode& A, const FOpenNode& B) { return A.Priority < B.Priority; };
+
+    const FVector GoalLocation{Nodes[GoalNode].Location};
+    TArray<FOpenNode, TInlineAllocator<256>> OpenNodes;
+
+    auto Open = [&](int32 Node, float Cost, int32 From)
+    {
+        SearchStamps[Node] = SearchStamp;
+        CostSoFar[Node] = Cost;
+        CameFrom[Node] = From;
+
+        // Straight line distance never overestimates, walking costs distance and climbing more
+        const float Heuristic{static_cast<float>(FVector::Dist(Nodes[Node].Location, GoalLocation))};
+        OpenNodes.HeapPush({Cost + Heuristic, Cost, Node}, ByPriority);
+    };
+
+    Open(StartNode, 0.f, INDEX_NONE);
+
+    while (!OpenNodes.IsEmpty())
+    {
+        FOpenNode Current;
+        OpenNodes.HeapPop(Current, ByPriority);
+
+        if (Current.Node == GoalNode) break;
+
+        // Reached cheaper after this entry was pushed
+        if (Current.Cost > CostSoFar[Current.Node]) continue;
+
+        for (const FClimbNavEdge& Edge : GetEdges(Current.Node))
+        {
+            const float Cost{Current.Cost + Edge.Cost};
+            if (SearchStamps[Edge.To] == SearchStamp && Cost >= CostSoFar[Edge.To]) continue;
+
+            Open(Edge.To, Cost, Current.Node);
+        }
+    }
+
+    if (SearchStamps[GoalNode] != SearchStamp) return false;
+
+    for (int32 Node = GoalNode; Node != INDEX_NONE; Node = CameFrom[Node])
+    {
+        OutNodes.Add(Node);
+    }
+    Algo::Reverse(OutNodes);
+
+    OutCost = CostSoFar[GoalNode];
+    return true;
+}
+
+SIZE_T FClimbNavGraph::GetAllocatedSize() const
+{
+    SIZE_T AllocatedSize{Nodes.GetAllocatedSize() + Edges.GetAllocatedSize() + Cells.GetAllocatedSize() +
+        CostSoFar.GetAllocatedSize() + CameFrom.GetAllocatedSize() + SearchStamps.GetAllocatedSize()};
+
+    for (const TPair<FIntVector, TArray<int32>>& Cell : Cells)
+    {
+        AllocatedSize += Cell.Value.GetAllocatedSize();
+    }
+
+    return AllocatedSize;
+}
+
+FIntVector FClimbNavGraph::GetCell(const FVector& Location) const
+{
+    return FIntVector(
+        FMath::FloorToInt(Location.X / CellSize),
+        FMath::FloorToInt(Location.Y / CellSize),
+        FMath::FloorToInt(Location.Z / CellSize));
+}
+
+//~ Begin UTickableWorldSubsystem Interface
+
+void UClimbNavGraphSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(
+        FOnActorSpawned::FDelegate::CreateUObject(this, &UClimbNavGraphSubsystem::OnActorSpawned));
+
+    ActorDestroyedHandle = InWorld.AddOnActorDestroyedHandler(
+        FOnActorDestroyed::FDelegate::CreateUObject(this, &UClimbNavGraphSubsystem::OnActorDestroyed));
+
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UClimbNavGraphSubsystem::OnLevelChanged);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UClimbNavGraphSubsystem::OnLevelChanged);
+}
+
+void UClimbNavGraphSubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+    }
+
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+    Super::Deinitialize();
+}
+
+void UClimbNavGraphSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (bGraphDirty)
+    {
+        RebuildTimer -= DeltaTime;
+        if (RebuildTimer <= 0.f)
+        {
+            StartRebuild();
+        }
+    }
+
+    if (bRebuilding)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_ClimbNavBuild);
+        LLM_SCOPE_BYTAG(ClimbingSystem);
+
+        for (int32 NumSampled = 0; NumSampled < ComponentsPerTick && !PendingComponents.IsEmpty(); )
+        {
+            if (const UPrimitiveComponent* Component = PendingComponents.Pop().Get())
+            {
+                SampleComponent(Component);
+                ++NumSampled;
+            }
+        }
+
+        if (PendingComponents.IsEmpty())
+        {
+            PendingGraph.Finalize(WalkLinkRadius, WalkLinkRadius);
+
+            Graph = MoveTemp(PendingGraph);
+            PendingGraph.Reset();
+            PathCache.Reset();
+
+            ++GraphVersion;
+            bRebuilding = false;
+
+            UE_LOG(LogTemp, Log, TEXT("Climb nav graph %u built: %d nodes, %llu bytes"),
+                GraphVersion, Graph.GetNodes().Num(), static_cast<uint64>(Graph.GetAllocatedSize()));
+        }
+    }
+
+#if ENABLE_DRAW_DEBUG
+    if (CVarClimbNavDraw.GetValueOnGameThread())
+    {
+        DrawGraph();
+    }
+#endif
+}
+
+TStatId UClimbNavGraphSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbNavGraphSubsystem, STATGROUP_Climbing);
+}
+
+bool UClimbNavGraphSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+//~ End UTickableWorldSubsystem Interface
+
+void UClimbNavGraphSubsystem::SetClimbableObjectTypes(const TArray<TEnumAsByte<EObjectTypeQuery>>& ObjectTypes,
+    bool bInClimbableChannelOnly)
+{
+    if (ObjectTypes == ClimbableObjectTypes && bInClimbableChannelOnly == bClimbableChannelOnly) return;
+
+    ClimbableObjectTypes = ObjectTypes;
+    bClimbableChannelOnly = bInClimbableChannelOnly;
+
+    // Nothing usable until the first build, skip the debounce
+    MarkGraphDirty();
+    RebuildTimer = 0.f;
+}
+
+void UClimbNavGraphSubsystem::MarkGraphDirty()
+{
+    if (ClimbableObjectTypes.IsEmpty()) return;
+
+    bGraphDirty = true;
+    RebuildTimer = RebuildDelay;
+}
+
+TSharedPtr<const FClimbNavPath> UClimbNavGraphSubsystem::FindPath(const FVector& Start, const FVector& Goal)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ClimbNavPathQuery);
+
+    const int32 StartNode{Graph.FindNearestNode(Start, EndpointSearchRadius, true)};
+    const int32 GoalNode{Graph.FindNearestNode(Goal, EndpointSearchRadius, true)};
+    if (StartNode == INDEX_NONE || GoalNode == INDEX_NONE) return nullptr;
+
+    const uint64 CacheKey{static_cast<uint64>(static_cast<uint32>(StartNode)) << 32 | static_cast<uint32>(GoalNode)};
+
+    if (const TSharedPtr<const FClimbNavPath>* CachedPath = PathCache.Find(CacheKey))
+    {
+        INC_DWORD_STAT(STAT_ClimbNavPathCacheHits);
+        return *CachedPath;
+    }
+
+    INC_DWORD_STAT(STAT_ClimbNavPathCacheMisses);
+    LLM_SCOPE_BYTAG(ClimbingSystem);
+
+    TSharedPtr<FClimbNavPath> Path;
+
+    TArray<int32> PathNodes;
+    float PathCost{0.f};
+    if (Graph.FindPath(StartNode, GoalNode, PathNodes, PathCost))
+    {
+        Path = MakeShared<FClimbNavPath>();
+        Path->Cost = PathCost;
+        Path->Points.Reserve(PathNodes.Num());
+
+        for (const int32 Node : PathNodes)
+        {
+            const FClimbNavNode& NavNode{Graph.GetNodes()[Node]};
+            Path->Points.Add({NavNode.Location, NavNode.Normal, NavNode.Type});
+        }
+    }
+
+    if (PathCache.Num() >= MaxCachedPaths)
+    {
+        PathCache.Reset();
+    }
+    PathCache.Add(CacheKey, Path);
+
+    return Path;
+}
+
+void UClimbNavGraphSubsystem::StartRebuild()
+{
+    bGraphDirty = false;
+    bRebuilding = true;
+
+    PendingGraph.Reset();
+    PendingComponents.Reset();
+
+    for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+    {
+        It->ForEachComponent<UPrimitiveComponent>(false, [this](const UPrimitiveComponent* Component)
+        {
+            if (IsClimbableGeometry(Component))
+            {
+                PendingComponents.Add(Component);
+            }
+        });
+    }
+}
+
+void UClimbNavGraphSubsystem::SampleComponent(const UPrimitiveComponent* Component)
+{
+    const UWorld* World{GetWorld()};
+    const FBox Bounds{Component->Bounds.GetBox()};
+    const FVector Center{Bounds.GetCenter()};
+    const FVector Extent{Bounds.GetExtent()};
+
+    FCollisionQueryParams QueryParams{SCENE_QUERY_STAT(ClimbNavSample), false};
+    const FCollisionObjectQueryParams ObjectParams{ClimbableObjectTypes};
+
+    // Rays into every vertical face of the bounds, each hit steep enough to climb becomes a node
+    for (const FVector& Direction : {FVector::ForwardVector, FVector::BackwardVector, FVector::RightVector, FVector::LeftVector})
+    {
+        const FVector Across{FVector::CrossProduct(FVector::UpVector, Direction)};
+        const float HalfWidth{static_cast<float>(FMath::Abs(FVector::DotProduct(Extent, Across)))};
+        const float HalfDepth{static_cast<float>(FMath::Abs(FVector::DotProduct(Extent, Direction)))};
+        const float HalfHeight{static_cast<float>(Extent.Z)};
+
+        const int32 NumColumns{FMath::Clamp(FMath::RoundToInt(2.f * HalfWidth / NodeSpacing), 1, MaxSamplesPerAxis)};
+        const int32 NumRows{FMath::Clamp(FMath::RoundToInt(2.f * HalfHeight / NodeSpacing), 1, MaxSamplesPerAxis)};
+        const float ColumnSpacing{2.f * HalfWidth / NumColumns};
+        const float RowSpacing{2.f * HalfHeight / NumRows};
+
+        TArray<int32> FaceNodes;
+        FaceNodes.Init(INDEX_NONE, NumColumns * NumRows);
+
+        auto GetFaceNode = [&FaceNodes, NumColumns, NumRows](int32 Column, int32 Row)
+        {
+            return Column >= 0 && Column < NumColumns && Row >= 0 && Row < NumRows ?
+                FaceNodes[Column * NumRows + Row] : INDEX_NONE;
+        };
+
+        for (int32 Column = 0; Column < NumColumns; ++Column)
+        {
+            for (int32 Row = 0; Row < NumRows; ++Row)
+            {
+                const FVector FaceOffset{Across * (-HalfWidth + (Column + 0.5f) * ColumnSpacing) +
+                    FVector::UpVector * (-HalfHeight + (Row + 0.5f) * RowSpacing)};
+                const FVector Start{Center + FaceOffset - Direction * (HalfDepth + NodeSpacing)};
+                const FVector End{Center + FaceOffset + Direction * (HalfDepth + NodeSpacing)};
+
+                FHitResult Hit;
+                if (!Component->LineTraceComponent(Hit, Start, End, QueryParams)) continue;
+
+                // Same stop rule as the climbing itself, and only faces looking back at the ray
+                const FVector Normal{Hit.ImpactNormal};
+                if (Normal.Z >= ClimbSurfaceMath::StopAngleCos || FVector::DotProduct(Normal, -Direction) < 0.5f) continue;
+
+                FaceNodes[Column * NumRows + Row] = PendingGraph.AddNode(
+                    Hit.ImpactPoint + Normal * NodeSurfaceOffset, Normal, EClimbNavNodeType::Climb);
+            }
+        }
+
+        const float MaxLinkDistance{2.f * FMath::Max(ColumnSpacing, RowSpacing)};
+
+        for (int32 Column = 0; Column < NumColumns; ++Column)
+        {
+            int32 TopNode{INDEX_NONE};
+            int32 BottomNode{INDEX_NONE};
+
+            for (int32 Row = 0; Row < NumRows; ++Row)
+            {
+                const int32 Node{GetFaceNode(Column, Row)};
+                if (Node == INDEX_NONE) continue;
+
+                BottomNode = BottomNode == INDEX_NONE ? Node : BottomNode;
+                TopNode = Node;
+
+                // Right, up and both diagonals, the rest links back to this node from its neighbours
+                for (const FIntPoint& Step : {FIntPoint(1, 0), FIntPoint(0, 1), FIntPoint(1, 1), FIntPoint(-1, 1)})
+                {
+                    const int32 Neighbour{GetFaceNode(Column + Step.X, Row + Step.Y)};
+                    if (Neighbour == INDEX_NONE) continue;
+
+                    const float Distance{static_cast<float>(FVector::Dist(
+                        PendingGraph.GetNodes()[Node].Location, PendingGraph.GetNodes()[Neighbour].Location))};
+
+                    // Gaps and steps in the wall are not climbable in one move
+                    if (Distance <= MaxLinkDistance)
+                    {
+                        PendingGraph.AddEdge(Node, Neighbour, Distance * ClimbCostMultiplier);
+                    }
+                }
+            }
+
+            if (TopNode == INDEX_NONE) continue;
+
+            // Mantle onto a walkable top, found the way TraceLedgeAbove finds it at runtime
+            const FClimbNavNode Top{PendingGraph.GetNodes()[TopNode]};
+            const FVector TopNormal{Top.Normal};
+            const FVector LedgeTraceStart{Top.Location - TopNormal * (NodeSurfaceOffset * 2.f) + FVector::UpVector * NodeSpacing};
+            const FVector LedgeTraceEnd{LedgeTraceStart - FVector::UpVector * NodeSpacing * 2.f};
+
+            FHitResult LedgeHit;
+            if (World->LineTraceSingleByObjectType(LedgeHit, LedgeTraceStart, LedgeTraceEnd, ObjectParams, QueryParams) &&
+                LedgeHit.ImpactNormal.Z >= WalkableFloorZ)
+            {
+                const int32 LedgeNode{PendingGraph.AddNode(LedgeHit.ImpactPoint, LedgeHit.ImpactNormal, EClimbNavNodeType::Ledge)};
+                PendingGraph.AddEdge(TopNode, LedgeNode, FVector::Dist(Top.Location, LedgeHit.ImpactPoint) * ClimbCostMultiplier);
+            }
+
+            // Floor at the foot of the wall, anything walkable counts
+            const FClimbNavNode Bottom{PendingGraph.GetNodes()[BottomNode]};
+            const FVector GroundTraceStart{Bottom.Location + FVector(Bottom.Normal) * NodeSurfaceOffset};
+            const FVector GroundTraceEnd{GroundTraceStart - FVector::UpVector * NodeSpacing * 2.f};
+
+            FHitResult GroundHit;
+            if (World->LineTraceSingleByChannel(GroundHit, GroundTraceStart, GroundTraceEnd, ECC_Visibility, QueryParams) &&
+                GroundHit.ImpactNormal.Z >= WalkableFloorZ)
+            {
+                const int32 GroundNode{PendingGraph.AddNode(GroundHit.ImpactPoint, GroundHit.ImpactNormal, EClimbNavNodeType::Ground)};
+                PendingGraph.AddEdge(BottomNode, GroundNode, FVector::Dist(Bottom.Location, GroundHit.ImpactPoint) * ClimbCostMultiplier);
+            }
+        }
+    }
+}
+
+bool UClimbNavGraphSubsystem::IsClimbableGeometry(const UPrimitiveComponent* Component) const
+{
+    // Only geometry that stays put, anything movable would invalidate the graph every frame
+    return Component &&
+        Component->IsRegistered() &&
+        Component->Mobility != EComponentMobility::Movable &&
+        Component->IsCollisionEnabled() &&
+        ClimbableObjectTypes.Contains(UEngineTypes::ConvertToObjectType(Component->GetCollisionObjectType())) &&
+        (!bClimbableChannelOnly || Component->GetCollisionResponseToChannel(ECC_Climbable) == ECR_Block);
+}
+
+bool UClimbNavGraphSubsystem::HasClimbableGeometry(const AActor* Actor) const
+{
+    bool bHasClimbableGeometry{false};
+
+    Actor->ForEachComponent<UPrimitiveComponent>(false, [this, &bHasClimbableGeometry](const UPrimitiveComponent* Component)
+    {
+        bHasClimbableGeometry |= IsClimbableGeometry(Component);
+    });
+
+    return bHasClimbableGeometry;
+}
+
+void UClimbNavGraphSubsystem::OnActorSpawned(AActor* Actor)
+{
+    if (Actor && HasClimbableGeometry(Actor))
+    {
+        MarkGraphDirty();
+    }
+}
+
+void UClimbNavGraphSubsystem::OnActorDestroyed(AActor* Actor)
+{
+    if (Actor && HasClimbableGeometry(Actor))
+    {
+        MarkGraphDirty();
+    }
+}
+
+void UClimbNavGraphSubsystem::OnLevelChanged(ULevel* Level, UWorld* World)
+{
+    if (World == GetWorld())
+    {
+        MarkGraphDirty();
+    }
+}
+
+#if ENABLE_DRAW_DEBUG
+void UClimbNavGraphSubsystem::DrawGraph() const
+{
+    const UWorld* World{GetWorld()};
+    const APlayerController* PlayerController{World->GetFirstPlayerController()};
+    if (!PlayerController || !PlayerController->GetPawn()) return;
+
+    const FVector ViewLocation{PlayerController->GetPawn()->GetActorLocation()};
+    constexpr float DrawRadius{2000.f};
+
+    const TArray<FClimbNavNode>& Nodes{Graph.GetNodes()};
+    for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+    {
+        const FClimbNavNode& Node{Nodes[Index]};
+        if (FVector::DistSquared(Node.Location, ViewLocation) > FMath::Square(DrawRadius)) continue;
+
+        const FColor Color{Node.Type == EClimbNavNodeType::Climb ? FColor::Cyan :
+            Node.Type == EClimbNavNodeType::Ledge ? FColor::Yellow : FColor::Green};
+
+        DrawDebugPoint(World, Node.Location, 6.f, Color);
+
+        for (const FClimbNavEdge& Edge : Graph.GetEdges(Index))
+        {
+            // Each edge is stored both ways, draw it once
+            if (Edge.To > Index)
+            {
+                DrawDebugLine(World, Node.Location, Nodes[Edge.To].Location, Color);
+            }
+        }
+    }
+}
+#endif
+
+static FAutoConsoleCommandWithWorld ClimbNavRebuildCommand(
+    TEXT("climb.Nav.Rebuild"),
+    TEXT("Rebuilds the climb navigation graph"),
+    FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+    {
+        if (UClimbNavGraphSubsystem* ClimbNavGraph = World ? World->GetSubsystem<UClimbNavGraphSubsystem>() : nullptr)
+        {
+            ClimbNavGraph->MarkGraphDirty();
+        }
+    }));
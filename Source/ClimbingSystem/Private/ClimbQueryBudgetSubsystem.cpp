@@ -0,0 +1,190 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbQueryBudgetSubsystem.h"
+#include "CustomMovementComponent.h"
+#include "ClimbingSystemStats.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+static TAutoConsoleVariable<int32> CVarClimbQueryBudgetPerFrame(
+    TEXT("climb.QueryBudgetPerFrame"),
+    256,
+    TEXT("Max climb physics queries issued per frame across all climbers. 0 disables the budget."));
+
+static TAutoConsoleVariable<float> CVarClimbQueryBudgetAgingWeight(
+    TEXT("climb.QueryBudgetAgingWeight"),
+    500.f,
+    TEXT("Priority a deferred climber gains per skipped frame, in cm of viewer distance."));
+
+
+//~ Begin UTickableWorldSubsystem Interface
+
+void UClimbQueryBudgetSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    // Tickables run after the actor tick groups, so this prepares next frame's grants
+    ScheduleQueries();
+}
+
+TStatId UClimbQueryBudgetSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbQueryBudgetSubsystem, STATGROUP_Climbing);
+}
+
+bool UClimbQueryBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+//~ End UTickableWorldSubsystem Interface
+
+void UClimbQueryBudgetSubsystem::RegisterClimber(UCustomMovementComponent* Climber)
+{
+    if (!Climber || ClimberIndices.Contains(Climber)) return;
+
+    LLM_SCOPE_BYTAG(ClimbingSystem);
+
+    FClimberEntry& Entry = Climbers.AddDefaulted_GetRef();
+    Entry.Climber = Climber;
+
+    ClimberIndices.Add(Climber, Climbers.Num() - 1);
+}
+
+void UClimbQueryBudgetSubsystem::UnregisterClimber(UCustomMovementComponent* Climber)
+{
+    int32 Index{INDEX_NONE};
+    if (!ClimberIndices.RemoveAndCopyValue(Climber, Index)) return;
+
+    // Keep the slot until the next schedule so the remaining indices stay valid
+    Climbers[Index].Climber.Reset();
+    Climbers[Index].GrantedQueries = 0;
+}
+
+bool UClimbQueryBudgetSubsystem::TryConsumeQueries(const UCustomMovementComponent* Climber, int32 NumQueries)
+{
+    if (CVarClimbQueryBudgetPerFrame.GetValueOnGameThread() <= 0) return true;
+
+    FClimberEntry* Entry{nullptr};
+    if (const int32* Index = ClimberIndices.Find(Climber))
+    {
+        Entry = &Climbers[*Index];
+    }
+
+    // Spend the reserved grant first, then fall back to whatever is left over
+    if (Entry && Entry->GrantedQueries >= NumQueries)
+    {
+        Entry->GrantedQueries -= NumQueries;
+        Entry->FramesSinceProbe = 0;
+        return true;
+    }
+
+    if (SpareQueries >= NumQueries)
+    {
+        SpareQueries -= NumQueries;
+        if (Entry)
+        {
+            Entry->FramesSinceProbe = 0;
+        }
+        return true;
+    }
+
+    INC_DWORD_STAT(STAT_ClimbProbesDeferred);
+    return false;
+}
+
+void UClimbQueryBudgetSubsystem::ScheduleQueries()
+{
+    SCOPE_CYCLE_COUNTER(STAT_ClimbScheduleQueries);
+
+    Climbers.RemoveAllSwap([](const FClimberEntry& Entry) { return !Entry.Climber.IsValid(); });
+
+    ViewLocations.Reset();
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        if (const APlayerController* PlayerController = It->Get())
+        {
+            FVector ViewLocation;
+            FRotator ViewRotation;
+            PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+            ViewLocations.Add(ViewLocation);
+        }
+    }
+
+    int32 NumActiveClimbers{0};
+    for (FClimberEntry& Entry : Climbers)
+    {
+        Entry.GrantedQueries = 0;
+        // Exempt climbers probe on their own and take nothing from the budget
+        Entry.bActive = Entry.Climber->IsInClimbTraversal() && !Entry.Climber->IsExemptFromClimbQueryBudget();
+
+        if (!Entry.bActive)
+        {
+            Entry.FramesSinceProbe = 0;
+            continue;
+        }
+
+        ++NumActiveClimbers;
+        Entry.Priority = CalculatePriority(Entry);
+    }
+
+    Climbers.Sort([](const FClimberEntry& A, const FClimberEntry& B)
+    {
+        if (A.bActive != B.bActive) return A.bActive;
+        return A.Priority > B.Priority;
+    });
+
+    const int32 QueryBudget{CVarClimbQueryBudgetPerFrame.GetValueOnGameThread()};
+    int32 PlannedQueries{0};
+
+    ClimberIndices.Reset();
+    for (int32 Index = 0; Index < Climbers.Num(); ++Index)
+    {
+        FClimberEntry& Entry = Climbers[Index];
+        ClimberIndices.Add(Entry.Climber.Get(), Index);
+
+        if (!Entry.bActive) continue;
+
+        const int32 ProbeCost{UCustomMovementComponent::ClimbProbeQueryCost};
+        if (PlannedQueries + ProbeCost <= QueryBudget)
+        {
+            Entry.GrantedQueries = ProbeCost;
+            PlannedQueries += ProbeCost;
+        }
+        else
+        {
+            ++Entry.FramesSinceProbe;
+        }
+    }
+
+    SpareQueries = FMath::Max(QueryBudget - PlannedQueries, 0);
+
+    SET_DWORD_STAT(STAT_ClimbActiveClimbers, NumActiveClimbers);
+}
+
+float UClimbQueryBudgetSubsystem::CalculatePriority(const FClimberEntry& Entry) const
+{
+    const UCustomMovementComponent* Climber{Entry.Climber.Get()};
+    const FVector ClimberLocation{Climber->GetActorLocation()};
+
+    float Priority{0.f};
+
+    // Nearer to any viewer is more important
+    float NearestViewDistSquared{TNumericLimits<float>::Max()};
+    for (const FVector& ViewLocation : ViewLocations)
+    {
+        NearestViewDistSquared = FMath::Min(NearestViewDistSquared,
+            static_cast<float>(FVector::DistSquared(ViewLocation, ClimberLocation)));
+    }
+
+    if (!ViewLocations.IsEmpty())
+    {
+        Priority -= FMath::Sqrt(NearestViewDistSquared);
+    }
+
+    // Aging guarantees every climber eventually gets a turn
+    Priority += Entry.FramesSinceProbe * CVarClimbQueryBudgetAgingWeight.GetValueOnGameThread();
+
+    return Priority;
+}
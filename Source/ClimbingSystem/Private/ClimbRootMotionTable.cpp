@@ -0,0 +1,160 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbRootMotionTable.h"
+#include "Animation/AnimMontage.h"
+#include "GameFramework/Character.h"
+
+FVector FClimbRootMotionTrack::SampleTranslation(float Time) const
+{
+    if (Translations.IsEmpty()) return FVector::ZeroVector;
+
+    const float SampleTime{FMath::Clamp(Time, 0.f, PlayLength) * SampleRate};
+    const int32 Index{FMath::Min(FMath::FloorToInt32(SampleTime), Translations.Num() - 1)};
+    const int32 NextIndex{FMath::Min(Index + 1, Translations.Num() - 1)};
+
+    return FVector(FMath::Lerp(Translations[Index], Translations[NextIndex], SampleTime - Index));
+}
+
+const FClimbRootMotionTrack* UClimbRootMotionTable::FindTrack(const TSoftObjectPtr<UAnimMontage>& Montage) const
+{
+    return GetTrack(FindTrackIndex(Montage));
+}
+
+int32 UClimbRootMotionTable::FindTrackIndex(const TSoftObjectPtr<UAnimMontage>& Montage) const
+{
+    if (Montage.IsNull()) return INDEX_NONE;
+
+    return Tracks.IndexOfByPredicate([&Montage](const FClimbRootMotionTrack& Track)
+    {
+        return Track.Montage == Montage;
+    });
+}
+
+#if WITH_EDITOR
+void UClimbRootMotionTable::BakeRootMotion()
+{
+    Tracks.Reset();
+
+    for (const TSoftObjectPtr<UAnimMontage>& SourceMontage : SourceMontages)
+    {
+        const UAnimMontage* Montage{SourceMontage.LoadSynchronous()};
+        if (!Montage) continue;
+
+        FClimbRootMotionTrack& Track = Tracks.AddDefaulted_GetRef();
+        Track.Montage = SourceMontage;
+        Track.PlayLength = Montage->GetPlayLength();
+        Track.SampleRate = BakeSampleRate;
+
+        // One sample past the end so the last interval lands exactly on PlayLength
+        const int32 NumSamples{FMath::CeilToInt32(Track.PlayLength * BakeSampleRate) + 1};
+        Track.Translations.Reserve(NumSamples);
+
+        for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+        {
+            const float SampleTime{FMath::Min(SampleIndex / BakeSampleRate, Track.PlayLength)};
+            const FTransform RootMotion{Montage->ExtractRootMotionFromTrackRange(0.f, SampleTime)};
+
+            Track.Translations.Add(FVector3f(RootMotion.GetTranslation()));
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("Baked %d root motion samples from %s"), NumSamples, *Montage->GetName());
+    }
+
+    MarkPackageDirty();
+}
+#endif
+
+FRootMotionSource_ClimbTrack::FRootMotionSource_ClimbTrack()
+{
+    InstanceName = TEXT("ClimbTrack");
+    AccumulateMode = ERootMotionAccumulateMode::Override;
+    FinishVelocityParams.Mode = ERootMotionFinishVelocityMode::SetVelocity;
+    FinishVelocityParams.SetVelocity = FVector::ZeroVector;
+}
+
+FRootMotionSource* FRootMotionSource_ClimbTrack::Clone() const
+{
+    return new FRootMotionSource_ClimbTrack(*this);
+}
+
+bool FRootMotionSource_ClimbTrack::Matches(const FRootMotionSource* Other) const
+{
+    if (!FRootMotionSource::Matches(Other)) return false;
+
+    const FRootMotionSource_ClimbTrack* OtherCast = static_cast<const FRootMotionSource_ClimbTrack*>(Other);
+
+    return Table == OtherCast->Table && TrackIndex == OtherCast->TrackIndex;
+}
+
+bool FRootMotionSource_ClimbTrack::MatchesAndHasSameState(const FRootMotionSource* Other) const
+{
+    if (!FRootMotionSource::MatchesAndHasSameState(Other)) return false;
+
+    const FRootMotionSource_ClimbTrack* OtherCast = static_cast<const FRootMotionSource_ClimbTrack*>(Other);
+
+    return MeshTransform.Equals(OtherCast->MeshTransform);
+}
+
+bool FRootMotionSource_ClimbTrack::UpdateStateFrom(const FRootMotionSource* SourceToTakeStateFrom, bool bMarkForSimulatedCatchup)
+{
+    if (!FRootMotionSource::UpdateStateFrom(SourceToTakeStateFrom, bMarkForSimulatedCatchup)) return false;
+
+    MeshTransform = static_cast<const FRootMotionSource_ClimbTrack*>(SourceToTakeStateFrom)->MeshTransform;
+
+    return true;
+}
+
+void FRootMotionSource_ClimbTrack::PrepareRootMotion(
+    float SimulationTime,
+    float MovementTickTime,
+    const ACharacter& Character,
+    const UCharacterMovementComponent& MoveComponent)
+{
+    RootMotionParams.Clear();
+
+    const FClimbRootMotionTrack* Track{Table ? Table->GetTrack(TrackIndex) : nullptr};
+
+    if (Track && MovementTickTime > UE_SMALL_NUMBER)
+    {
+        const FVector LocalDelta{Track->SampleTranslation(GetTime() + SimulationTime) - Track->SampleTranslation(GetTime())};
+        const FVector WorldVelocity{MeshTransform.TransformVector(LocalDelta) / MovementTickTime};
+
+        RootMotionParams.Set(FTransform(WorldVelocity));
+    }
+
+    SetTime(GetTime() + SimulationTime);
+}
+
+bool FRootMotionSource_ClimbTrack::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    if (!FRootMotionSource::NetSerialize(Ar, Map, bOutSuccess)) return false;
+
+    UObject* TableObject{Table.Get()};
+    Ar << TableObject;
+    Table = Cast<UClimbRootMotionTable>(TableObject);
+
+    Ar << TrackIndex;
+    Ar << MeshTransform;
+
+    bOutSuccess = true;
+    return true;
+}
+
+UScriptStruct* FRootMotionSource_ClimbTrack::GetScriptStruct() const
+{
+    return FRootMotionSource_ClimbTrack::StaticStruct();
+}
+
+FString FRootMotionSource_ClimbTrack::ToSimpleString() const
+{
+    return FString::Printf(TEXT("[ID:%u]FRootMotionSource_ClimbTrack %s Track %d"),
+        LocalID, *GetNameSafe(Table), TrackIndex);
+}
+
+void FRootMotionSource_ClimbTrack::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    Collector.AddReferencedObject(Table);
+
+    FRootMotionSource::AddReferencedObjects(Collector);
+}
@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbSavedMove.h"
+#include "GameFramework/Character.h"
+
+static UCustomMovementComponent* GetClimbMovement(const ACharacter* Character)
+{
+    return Character ? Cast<UCustomMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+}
+
+//~ Begin FSavedMove_Character Interface
+
+void FSavedMove_Climb::Clear()
+{
+    Super::Clear();
+
+    StartClimbState = FClimbStateSnapshot();
+    ClimbProbes.Reset();
+
+    bWantsAutoMantle = false;
+    bWantsAutoLedgeGrab = false;
+    bWantsClimbJump = false;
+}
+
+void FSavedMove_Climb::SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel,
+    FNetworkPredictionData_Client_Character& ClientData)
+{
+    Super::SetMoveFor(Character, InDeltaTime, NewAccel, ClientData);
+
+    if (UCustomMovementComponent* ClimbMovement = GetClimbMovement(Character))
+    {
+        StartClimbState = ClimbMovement->CaptureClimbStateSnapshot();
+
+        bWantsAutoMantle = ClimbMovement->WantsAutoMantle();
+        bWantsAutoLedgeGrab = ClimbMovement->WantsAutoLedgeGrab();
+        bWantsClimbJump = ClimbMovement->WantsClimbJump();
+
+        // Drop anything recorded outside of a saved move, this move records from a clean slate
+        ClimbMovement->ConsumeRecordedClimbProbes();
+    }
+}
+
+bool FSavedMove_Climb::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+    const FSavedMove_Climb* NewClimbMove{static_cast<const FSavedMove_Climb*>(NewMove.Get())};
+
+    // Keep climb mode changes apart so each replayed move lines up with its own probes, moves with
+    // root motion (climb transitions) are never combined by the base class
+    if (StartClimbState.CustomMode != NewClimbMove->StartClimbState.CustomMode ||
+        bWantsAutoMantle || NewClimbMove->bWantsAutoMantle || bWantsAutoLedgeGrab || NewClimbMove->bWantsAutoLedgeGrab ||
+        bWantsClimbJump || NewClimbMove->bWantsClimbJump)
+    {
+        return false;
+    }
+
+    return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void FSavedMove_Climb::CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC,
+    const FVector& OldStartLocation)
+{
+    Super::CombineWith(OldMove, InCharacter, PC, OldStartLocation);
+
+    // The combined move is performed again from where the old one started, climb state included
+    if (UCustomMovementComponent* ClimbMovement = GetClimbMovement(InCharacter))
+    {
+        StartClimbState = static_cast<const FSavedMove_Climb*>(OldMove)->StartClimbState;
+        ClimbMovement->ApplyClimbStateSnapshot(StartClimbState);
+    }
+}
+
+void FSavedMove_Climb::PrepMoveFor(ACharacter* Character)
+{
+    Super::PrepMoveFor(Character);
+
+    if (UCustomMovementComponent* ClimbMovement = GetClimbMovement(Character))
+    {
+        ClimbMovement->SetReplayedClimbProbes(ClimbProbes);
+    }
+}
+
+void FSavedMove_Climb::PostUpdate(ACharacter* Character, EPostUpdateMode PostUpdateMode)
+{
+    Super::PostUpdate(Character, PostUpdateMode);
+
+    // Replays keep the probes of the original move, a replay that had to trace again drifted off it
+    if (PostUpdateMode != PostUpdate_Record) return;
+
+    if (UCustomMovementComponent* ClimbMovement = GetClimbMovement(Character))
+    {
+        ClimbProbes = ClimbMovement->ConsumeRecordedClimbProbes();
+    }
+}
+
+uint8 FSavedMove_Climb::GetCompressedFlags() const
+{
+    uint8 Result{Super::GetCompressedFlags()};
+
+    if (bWantsAutoMantle)
+    {
+        Result |= FLAG_Custom_0;
+    }
+    if (bWantsAutoLedgeGrab)
+    {
+        Result |= FLAG_Custom_1;
+    }
+    if (bWantsClimbJump)
+    {
+        Result |= FLAG_Custom_2;
+    }
+
+    return Result;
+}
+
+//~ End FSavedMove_Character Interface
+
+FNetworkPredictionData_Client_Climb::FNetworkPredictionData_Client_Climb(const UCharacterMovementComponent& ClientMovement)
+    : Super(ClientMovement)
+{
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_Climb::AllocateNewMove()
+{
+    return FSavedMovePtr(new FSavedMove_Climb());
+}
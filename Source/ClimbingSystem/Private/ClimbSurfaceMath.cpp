@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbSurfaceMath.h"
+
+namespace ClimbSurfaceMath
+{
+    FClimbSurfaceInfo EstimateSurface(TConstArrayView<FClimbSurfaceSample> Samples,
+        const FVector& Origin, float OutlierAngle)
+    {
+        FClimbSurfaceInfo Surface;
+
+        if (Samples.IsEmpty()) return Surface;
+
+        // Hits closer to the character describe the surface under the hands better
+        auto GetSampleWeight = [&Origin](const FClimbSurfaceSample& Sample)
+        {
+            return 1.f / FMath::Max(static_cast<float>(FVector::Dist(Sample.ImpactPoint, Origin)), 1.f);
+        };
+
+        FVector MeanNormal{FVector::ZeroVector};
+        for (const FClimbSurfaceSample& Sample : Samples)
+        {
+            MeanNormal += FVector(Sample.ImpactNormal) * GetSampleWeight(Sample);
+        }
+        MeanNormal = MeanNormal.GetSafeNormal();
+
+        // Second pass drops outliers such as the side faces of corners and edges
+        const float OutlierCos{FMath::Cos(FMath::DegreesToRadians(OutlierAngle))};
+
+        float TotalWeight{0.f};
+        for (const FClimbSurfaceSample& Sample : Samples)
+        {
+            if (FVector::DotProduct(FVector(Sample.ImpactNormal), MeanNormal) < OutlierCos) continue;
+
+            const float Weight{GetSampleWeight(Sample)};
+            Surface.Location += Sample.ImpactPoint * Weight;
+            Surface.Normal += FVector(Sample.ImpactNormal) * Weight;
+            TotalWeight += Weight;
+        }
+
+        // Every hit disagreed with the mean, fall back to plain averaging
+        if (TotalWeight <= 0.f)
+        {
+            for (const FClimbSurfaceSample& Sample : Samples)
+            {
+                Surface.Location += Sample.ImpactPoint;
+                Surface.Normal += FVector(Sample.ImpactNormal);
+            }
+            TotalWeight = Samples.Num();
+        }
+
+        Surface.Location /= TotalWeight;
+        Surface.Normal = Surface.Normal.GetSafeNormal();
+
+        return Surface;
+    }
+
+    FVector SmoothNormal(const FVector& PreviousNormal, const FVector& NewNormal,
+        float DeltaTime, float SmoothingTime)
+    {
+        // Low pass the normal so noisy geometry does not make the rotation chase it
+        const bool bCanFilter{DeltaTime > 0.f && SmoothingTime > 0.f &&
+            FVector::DotProduct(PreviousNormal, NewNormal) > 0.f};
+
+        if (!bCanFilter) return NewNormal;
+
+        const float Alpha{1.f - FMath::Exp(-DeltaTime / SmoothingTime)};
+        return FMath::Lerp(PreviousNormal, NewNormal, Alpha).GetSafeNormal();
+    }
+}
@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbSurfacePhysicalMaterial.h"
+
+FClimbSurfaceProperties FClimbSurfaceProperties::Combine(const FClimbSurfaceProperties& A, const FClimbSurfaceProperties& B)
+{
+    FClimbSurfaceProperties Combined;
+    Combined.SpeedScale = FMath::Min(A.SpeedScale, B.SpeedScale);
+    Combined.Grip = FMath::Min(A.Grip, B.Grip);
+    Combined.StopAngleCos = FMath::Min(A.StopAngleCos, B.StopAngleCos);
+
+    return Combined;
+}
+
+FClimbSurfaceProperties UClimbSurfacePhysicalMaterial::GetClimbSurfaceProperties(const UPhysicalMaterial* PhysicalMaterial)
+{
+    FClimbSurfaceProperties Properties;
+
+    if (const UClimbSurfacePhysicalMaterial* ClimbMaterial = Cast<UClimbSurfacePhysicalMaterial>(PhysicalMaterial))
+    {
+        Properties.SpeedScale = ClimbMaterial->ClimbSpeedScale;
+        Properties.Grip = ClimbMaterial->ClimbGrip;
+        Properties.StopAngleCos = FMath::Cos(FMath::DegreesToRadians(ClimbMaterial->ClimbStopAngle));
+    }
+
+    return Properties;
+}
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbTelemetry.h"
+#include "CustomMovementComponent.h"
+#include "Engine/World.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/UObjectIterator.h"
+
+// Identifies climb telemetry dumps, bump the version when FClimbTelemetryFrame changes
+static constexpr uint32 ClimbTelemetryFileMagic{0x4D544C43}; // "CLTM"
+static constexpr uint32 ClimbTelemetryFileVersion{2};
+
+void FClimbTelemetryRingBuffer::Initialize(int32 Capacity)
+{
+    Frames.SetNumZeroed(FMath::Max(Capacity, 0));
+    WriteCount.store(0, std::memory_order_relaxed);
+}
+
+void FClimbTelemetryRingBuffer::Record(const FClimbTelemetryFrame& Frame)
+{
+    if (Frames.IsEmpty()) return;
+
+    const uint32 Count{WriteCount.load(std::memory_order_relaxed)};
+    Frames[Count % Frames.Num()] = Frame;
+
+    // Publish the slot only after it has been written
+    WriteCount.store(Count + 1, std::memory_order_release);
+}
+
+void FClimbTelemetryRingBuffer::CopyFrames(TArray<FClimbTelemetryFrame>& OutFrames) const
+{
+    OutFrames.Reset();
+    if (Frames.IsEmpty()) return;
+
+    const uint32 Count{WriteCount.load(std::memory_order_acquire)};
+    const uint32 Capacity{static_cast<uint32>(Frames.Num())};
+    const uint32 NumFrames{FMath::Min(Count, Capacity)};
+
+    OutFrames.Reserve(NumFrames);
+    for (uint32 Index = Count - NumFrames; Index != Count; ++Index)
+    {
+        OutFrames.Add(Frames[Index % Capacity]);
+    }
+}
+
+bool FClimbTelemetryRingBuffer::SaveToFile(const FString& Filename) const
+{
+    TArray<FClimbTelemetryFrame> OrderedFrames;
+    CopyFrames(OrderedFrames);
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+
+    uint32 Magic{ClimbTelemetryFileMagic};
+    uint32 Version{ClimbTelemetryFileVersion};
+    uint32 FrameSize{sizeof(FClimbTelemetryFrame)};
+    uint32 NumFrames{static_cast<uint32>(OrderedFrames.Num())};
+
+    Writer << Magic << Version << FrameSize << NumFrames;
+    Writer.Serialize(OrderedFrames.GetData(), OrderedFrames.Num() * sizeof(FClimbTelemetryFrame));
+
+    return FFileHelper::SaveArrayToFile(Bytes, *Filename);
+}
+
+void FClimbTelemetryDebugRenderer::Draw(UWorld* World, const FClimbTelemetryRingBuffer& Telemetry)
+{
+    if (!World || !World->LineBatcher) return;
+
+    Telemetry.CopyFrames(FrameScratch);
+
+    Lines.Reset();
+
+    for (const FClimbTelemetryFrame& Frame : FrameScratch)
+    {
+        const FVector Location{Frame.Location};
+
+        // Red where the solver wanted to stop, cyan while waiting on streaming, yellow on transitions, green otherwise
+        FLinearColor Color{FLinearColor::Green};
+        if (Frame.Flags & EClimbTelemetryFlags::ShouldStop)
+        {
+            Color = FLinearColor::Red;
+        }
+        else if (Frame.Flags & EClimbTelemetryFlags::StreamingHold)
+        {
+            Color = FLinearColor(0.f, 1.f, 1.f);
+        }
+        else if (Frame.Flags & EClimbTelemetryFlags::ModeChanged)
+        {
+            Color = FLinearColor::Yellow;
+        }
+
+        Lines.Emplace(Location, Location + FVector(Frame.SurfaceNormal) * 30.f, Color, 0.f, 0.5f, SDPG_World);
+
+        if (!Frame.SnapVector.IsNearlyZero())
+        {
+            Lines.Emplace(Location, Location + FVector(Frame.SnapVector), FLinearColor::Blue, 0.f, 0.5f, SDPG_World);
+        }
+    }
+
+    World->LineBatcher->DrawLines(Lines);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs DumpClimbTelemetryCommand(
+    TEXT("climb.Telemetry.Dump"),
+    TEXT("Writes the climb telemetry of every climber in the world to Saved/ClimbTelemetry"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+    {
+        const FString DumpDirectory{FPaths::ProjectSavedDir() / TEXT("ClimbTelemetry")};
+        const FString Timestamp{FDateTime::Now().ToString()};
+
+        for (TObjectIterator<UCustomMovementComponent> It; It; ++It)
+        {
+            if (It->GetWorld() != World || !It->GetOwner()) continue;
+
+            const FString Filename{DumpDirectory / FString::Printf(TEXT("%s_%s.bin"),
+                *It->GetOwner()->GetName(), *Timestamp)};
+
+            if (It->GetClimbTelemetry().SaveToFile(Filename))
+            {
+                UE_LOG(LogTemp, Log, TEXT("Climb telemetry written to %s"), *Filename);
+            }
+            else
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Failed to write climb telemetry to %s"), *Filename);
+            }
+        }
+    }));
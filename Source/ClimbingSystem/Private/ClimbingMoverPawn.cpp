@@ -0,0 +1,179 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbingMoverPawn.h"
+#include "ClimbMoverMode.h"
+#include "Camera/CameraComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Backends/MoverNetworkPhysicsLiaison.h"
+#include "Engine/LocalPlayer.h"
+#include "EnhancedInputComponent.h"
+#include "EnhancedInputSubsystems.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "InputActionValue.h"
+#include "InputMappingContext.h"
+#include "MoverComponent.h"
+#include "MoverDataModelTypes.h"
+#include "PhysicsMover/Modes/PhysicsDrivenFallingMode.h"
+#include "PhysicsMover/Modes/PhysicsDrivenWalkingMode.h"
+#include "UObject/ConstructorHelpers.h"
+
+AClimbingMoverPawn::AClimbingMoverPawn(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    CapsuleComponent = CreateDefaultSubobject<UCapsuleComponent>(TEXT("CapsuleComponent"));
+    CapsuleComponent->InitCapsuleSize(42.f, 90.f);
+    CapsuleComponent->SetCollisionProfileName(UCollisionProfile::Pawn_ProfileName);
+    // The physics liaison moves the capsule's body, not the component
+    CapsuleComponent->SetSimulatePhysics(true);
+    RootComponent = CapsuleComponent;
+
+    // Refreshes the climb surface probe for the physics thread simulation
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.TickGroup = TG_PrePhysics;
+
+    Mesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("Mesh"));
+    Mesh->SetupAttachment(CapsuleComponent);
+    Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+    // Modes find their component through their outer, so they are created inside it
+    MoverComponent = CreateDefaultSubobject<UMoverComponent>(TEXT("MoverComponent"));
+    MoverComponent->BackendClass = UMoverNetworkPhysicsLiaisonComponent::StaticClass();
+    ClimbMode = ObjectInitializer.CreateDefaultSubobject<UClimbMoverMode>(MoverComponent, TEXT("ClimbMode"));
+
+    MoverComponent->MovementModes.Add(DefaultModeNames::Walking, ObjectInitializer.CreateDefaultSubobject<UPhysicsDrivenWalkingMode>(MoverComponent, TEXT("WalkingMode")));
+    MoverComponent->MovementModes.Add(DefaultModeNames::Falling, ObjectInitializer.CreateDefaultSubobject<UPhysicsDrivenFallingMode>(MoverComponent, TEXT("FallingMode")));
+    MoverComponent->MovementModes.Add(UClimbMoverMode::ModeName, ClimbMode);
+    MoverComponent->Transitions.Add(ObjectInitializer.CreateDefaultSubobject<UClimbMoverToggleTransition>(MoverComponent, TEXT("ClimbToggleTransition")));
+    MoverComponent->StartingMovementMode = DefaultModeNames::Falling;
+
+    SetReplicatingMovement(false);
+
+    CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
+    CameraBoom->SetupAttachment(CapsuleComponent);
+    CameraBoom->TargetArmLength = 400.f;
+    CameraBoom->bUsePawnControlRotation = true;
+
+    FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
+    FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
+    FollowCamera->bUsePawnControlRotation = false;
+
+    // Spawned from C++ by the game mode, so it references the template input assets directly
+    static ConstructorHelpers::FObjectFinder<UInputMappingContext> MappingContextAsset(TEXT("/Game/ThirdPerson/Input/IMC_Default"));
+    static ConstructorHelpers::FObjectFinder<UInputAction> JumpActionAsset(TEXT("/Game/ThirdPerson/Input/Actions/IA_Jump"));
+    static ConstructorHelpers::FObjectFinder<UInputAction> MoveActionAsset(TEXT("/Game/ThirdPerson/Input/Actions/IA_Move"));
+    static ConstructorHelpers::FObjectFinder<UInputAction> LookActionAsset(TEXT("/Game/ThirdPerson/Input/Actions/IA_Look"));
+    static ConstructorHelpers::FObjectFinder<UInputAction> ClimbActionAsset(TEXT("/Game/ThirdPerson/Input/Actions/IA_Climb"));
+
+    DefaultMappingContext = MappingContextAsset.Object;
+    JumpAction = JumpActionAsset.Object;
+    MoveAction = MoveActionAsset.Object;
+    LookAction = LookActionAsset.Object;
+    ClimbAction = ClimbActionAsset.Object;
+}
+
+void AClimbingMoverPawn::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    // Scene queries are not allowed on the physics thread, the simulation reads this probe instead
+    if (GetLocalRole() != ROLE_SimulatedProxy)
+    {
+        ClimbMode->RefreshSurface(CapsuleComponent);
+    }
+}
+
+void AClimbingMoverPawn::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
+{
+    if (APlayerController* PlayerController = Cast<APlayerController>(GetController()))
+    {
+        if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))
+        {
+            Subsystem->AddMappingContext(DefaultMappingContext, 0);
+        }
+    }
+
+    UEnhancedInputComponent* EnhancedInputComponent{Cast<UEnhancedInputComponent>(PlayerInputComponent)};
+    if (!EnhancedInputComponent)
+    {
+        UE_LOG(LogTemp, Error, TEXT("%s needs an Enhanced Input component"), *GetNameSafe(this));
+        return;
+    }
+
+    EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Started, this, &AClimbingMoverPawn::OnJumpActionStarted);
+    EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Completed, this, &AClimbingMoverPawn::OnJumpActionCompleted);
+    EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Triggered, this, &AClimbingMoverPawn::Move);
+    EnhancedInputComponent->BindAction(LookAction, ETriggerEvent::Triggered, this, &AClimbingMoverPawn::Look);
+    EnhancedInputComponent->BindAction(ClimbAction, ETriggerEvent::Started, this, &AClimbingMoverPawn::OnClimbActionStarted);
+}
+
+void AClimbingMoverPawn::Move(const FInputActionValue& Value)
+{
+    if (!Controller) return;
+
+    // World space and yaw relative, UClimbMoverMode maps it onto the wall like the character does
+    const FVector2D MovementVector{Value.Get<FVector2D>()};
+    const FRotator YawRotation{0.f, Controller->GetControlRotation().Yaw, 0.f};
+
+    AddMovementInput(FRotationMatrix(YawRotation).GetUnitAxis(EAxis::X), MovementVector.Y);
+    AddMovementInput(FRotationMatrix(YawRotation).GetUnitAxis(EAxis::Y), MovementVector.X);
+}
+
+void AClimbingMoverPawn::Look(const FInputActionValue& Value)
+{
+    const FVector2D LookAxisVector{Value.Get<FVector2D>()};
+
+    AddControllerYawInput(LookAxisVector.X);
+    AddControllerPitchInput(LookAxisVector.Y);
+}
+
+void AClimbingMoverPawn::OnJumpActionStarted(const FInputActionValue& Value)
+{
+    bJumpPressed = true;
+    bJumpJustPressed = true;
+}
+
+void AClimbingMoverPawn::OnJumpActionCompleted(const FInputActionValue& Value)
+{
+    bJumpPressed = false;
+}
+
+void AClimbingMoverPawn::OnClimbActionStarted(const FInputActionValue& Value)
+{
+    RequestToggleClimbing(!IsClimbing());
+}
+
+//~ Begin IMoverInputProducerInterface Interface
+
+void AClimbingMoverPawn::ProduceInput_Implementation(int32 SimTimeMs, FMoverInputCmdContext& InputCmdResult)
+{
+    FCharacterDefaultInputs& CharacterInputs = InputCmdResult.InputCollection.FindOrAddMutableDataByType<FCharacterDefaultInputs>();
+
+    const FVector MoveInput{ConsumeMovementInputVector().GetClampedToMaxSize(1.f)};
+
+    CharacterInputs.SetMoveInput(EMoveInputType::DirectionalIntent, MoveInput);
+    CharacterInputs.OrientationIntent = MoveInput.GetSafeNormal();
+    CharacterInputs.ControlRotation = Controller ? Controller->GetControlRotation() : GetActorRotation();
+
+    CharacterInputs.bIsJumpPressed = bJumpPressed;
+    CharacterInputs.bIsJumpJustPressed = bJumpJustPressed;
+    bJumpJustPressed = false;
+
+    FClimbMoverInputs& ClimbInputs = InputCmdResult.InputCollection.FindOrAddMutableDataByType<FClimbMoverInputs>();
+    ClimbInputs.bIsClimbToggleJustPressed = bClimbToggleJustPressed;
+    bClimbToggleJustPressed = false;
+}
+
+//~ End IMoverInputProducerInterface Interface
+
+void AClimbingMoverPawn::RequestToggleClimbing(bool bEnableClimb)
+{
+    bClimbToggleJustPressed = bEnableClimb != IsClimbing();
+}
+
+bool AClimbingMoverPawn::IsClimbing() const
+{
+    return MoverComponent->GetMovementModeName() == UClimbMoverMode::ModeName;
+}
@@ -0,0 +1,353 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbingReplicationGraph.h"
+#include "CustomMovementComponent.h"
+#include "ClimbingSystemStats.h"
+#include "GameFramework/Character.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+
+static TAutoConsoleVariable<bool> CVarClimbRepGraphClimbNode(
+    TEXT("climb.RepGraph.ClimbNode"),
+    true,
+    TEXT("Route climbing characters to the 3D climb node. Off keeps them on the basic 2D grid, for comparisons. Read when the graph starts."));
+
+UReplicationGraphNode_ClimbSpatialization3D::UReplicationGraphNode_ClimbSpatialization3D()
+{
+    bRequiresPrepareForReplicationCall = true;
+}
+
+//~ Begin UReplicationGraphNode Interface
+
+void UReplicationGraphNode_ClimbSpatialization3D::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+    const ACharacter* Character{Cast<ACharacter>(ActorInfo.GetActor())};
+    if (!Character) return;
+
+    FClimberActor& Climber = Climbers.AddDefaulted_GetRef();
+    Climber.Actor = ActorInfo.Actor;
+    Climber.MovementComponent = Cast<UCustomMovementComponent>(Character->GetCharacterMovement());
+}
+
+bool UReplicationGraphNode_ClimbSpatialization3D::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+    // Cells hold indices, they are rebuilt in PrepareForReplication before the next gather
+    const int32 Index{Climbers.IndexOfByPredicate([&ActorInfo](const FClimberActor& Climber)
+    {
+        return Climber.Actor == ActorInfo.Actor;
+    })};
+
+    if (Index == INDEX_NONE)
+    {
+        UE_CLOG(bWarnIfNotFound, LogTemp, Warning, TEXT("%s: %s was not in the climb node"),
+            *GetName(), *GetNameSafe(ActorInfo.GetActor()));
+        return false;
+    }
+
+    Climbers.RemoveAtSwap(Index);
+    return true;
+}
+
+void UReplicationGraphNode_ClimbSpatialization3D::NotifyResetAllNetworkActors()
+{
+    Climbers.Reset();
+    ClimbingCells.Reset();
+    GroundCells.Reset();
+}
+
+void UReplicationGraphNode_ClimbSpatialization3D::PrepareForReplication()
+{
+    for (TPair<FIntVector, TArray<int32>>& Cell : ClimbingCells)
+    {
+        Cell.Value.Reset();
+    }
+    for (TPair<FIntVector, TArray<int32>>& Cell : GroundCells)
+    {
+        Cell.Value.Reset();
+    }
+
+    float MaxCullDistanceSquared{0.f};
+
+    for (int32 Index = 0; Index < Climbers.Num(); ++Index)
+    {
+        AActor* Actor{Climbers[Index].Actor};
+        const UCustomMovementComponent* MovementComponent{Climbers[Index].MovementComponent.Get()};
+        if (!IsValid(Actor)) continue;
+
+        MaxCullDistanceSquared = FMath::Max(MaxCullDistanceSquared,
+            GraphGlobals->GlobalActorReplicationInfoMap->Get(Actor).Settings.GetCullDistanceSquared());
+
+        const FIntVector Cell{GetCell(Actor->GetActorLocation())};
+
+        if (MovementComponent && MovementComponent->IsClimbing())
+        {
+            ClimbingCells.FindOrAdd(Cell).Add(Index);
+        }
+        else
+        {
+            GroundCells.FindOrAdd(FIntVector(Cell.X, Cell.Y, 0)).Add(Index);
+        }
+    }
+
+    CellSearchRadius = FMath::Max(FMath::CeilToInt32(FMath::Sqrt(MaxCullDistanceSquared) / CellSize), 1);
+}
+
+void UReplicationGraphNode_ClimbSpatialization3D::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ClimbRepGraphGather);
+
+    const double GatherStartTime{FPlatformTime::Seconds()};
+
+    if (LastStatsFrame != Params.ReplicationFrameNum)
+    {
+        LastStatsFrame = Params.ReplicationFrameNum;
+        LastFrameStats.Reset();
+    }
+
+    FConnectionGatherStats& Stats = LastFrameStats.AddDefaulted_GetRef();
+    Stats.ConnectionName = GetNameSafe(Params.ConnectionManager.NetConnection);
+
+    ++GatherId;
+    GatheredActors.Reset(Climbers.Num());
+
+    // Large cull distances make the search box huge, walk the occupied cells instead when there are fewer
+    const int32 SearchWidth{2 * CellSearchRadius + 1};
+    const int32 NumGroundSearchCells{SearchWidth * SearchWidth};
+    const int64 NumClimbingSearchCells{static_cast<int64>(NumGroundSearchCells) * SearchWidth};
+
+    for (const FNetViewer& Viewer : Params.Viewers)
+    {
+        const FIntVector ViewerCell{GetCell(Viewer.ViewLocation)};
+        const FIntVector ViewerColumn{ViewerCell.X, ViewerCell.Y, 0};
+
+        if (GroundCells.Num() < NumGroundSearchCells)
+        {
+            for (const TPair<FIntVector, TArray<int32>>& Cell : GroundCells)
+            {
+                if (IsWithinSearchRadius(Cell.Key, ViewerColumn))
+                {
+                    GatherFromCell(&Cell.Value, Viewer, Params, Stats);
+                }
+            }
+        }
+        else
+        {
+            for (int32 X = -CellSearchRadius; X <= CellSearchRadius; ++X)
+            {
+                for (int32 Y = -CellSearchRadius; Y <= CellSearchRadius; ++Y)
+                {
+                    GatherFromCell(GroundCells.Find(ViewerColumn + FIntVector(X, Y, 0)), Viewer, Params, Stats);
+                }
+            }
+        }
+
+        if (ClimbingCells.Num() < NumClimbingSearchCells)
+        {
+            for (const TPair<FIntVector, TArray<int32>>& Cell : ClimbingCells)
+            {
+                if (IsWithinSearchRadius(Cell.Key, ViewerCell))
+                {
+                    GatherFromCell(&Cell.Value, Viewer, Params, Stats);
+                }
+            }
+        }
+        else
+        {
+            for (int32 X = -CellSearchRadius; X <= CellSearchRadius; ++X)
+            {
+                for (int32 Y = -CellSearchRadius; Y <= CellSearchRadius; ++Y)
+                {
+                    for (int32 Z = -CellSearchRadius; Z <= CellSearchRadius; ++Z)
+                    {
+                        GatherFromCell(ClimbingCells.Find(ViewerCell + FIntVector(X, Y, Z)), Viewer, Params, Stats);
+                    }
+                }
+            }
+        }
+    }
+
+    if (GatheredActors.Num() > 0)
+    {
+        Params.OutGatheredReplicationLists.AddReplicationActorList(GatheredActors);
+    }
+
+    Stats.NumRelevant = GatheredActors.Num();
+    Stats.GatherSeconds = FPlatformTime::Seconds() - GatherStartTime;
+}
+
+void UReplicationGraphNode_ClimbSpatialization3D::LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const
+{
+    DebugInfo.Log(FString::Printf(TEXT("%s: %d characters, %d climbing cells, %d ground cells"),
+        *NodeName, Climbers.Num(), ClimbingCells.Num(), GroundCells.Num()));
+}
+
+//~ End UReplicationGraphNode Interface
+
+void UReplicationGraphNode_ClimbSpatialization3D::GatherFromCell(const TArray<int32>* CellActors, const FNetViewer& Viewer,
+    const FConnectionGatherActorListParameters& Params, FConnectionGatherStats& Stats)
+{
+    if (!CellActors) return;
+
+    const float FullRateDistanceSquared{FMath::Square(FullRateDistance)};
+
+    for (const int32 Index : *CellActors)
+    {
+        if (!Climbers.IsValidIndex(Index)) continue;
+
+        FClimberActor& Climber = Climbers[Index];
+        if (Climber.LastGatherId == GatherId || !IsValid(Climber.Actor)) continue;
+
+        const UCustomMovementComponent* MovementComponent{Climber.MovementComponent.Get()};
+        const FVector ToClimber{Climber.Actor->GetActorLocation() - Viewer.ViewLocation};
+
+        FConnectionReplicationActorInfo& ConnectionInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(Climber.Actor);
+        if (ToClimber.SizeSquared() > ConnectionInfo.GetCullDistanceSquared()) continue;
+
+        Climber.LastGatherId = GatherId;
+        GatheredActors.Add(Climber.Actor);
+
+        // Climbers out of the viewer's way still replicate, just less often
+        const uint8 BasePeriodFrames{static_cast<uint8>(
+            GraphGlobals->GlobalActorReplicationInfoMap->Get(Climber.Actor).Settings.ReplicationPeriodFrame)};
+
+        const bool bReducedRate{MovementComponent && MovementComponent->IsClimbing() &&
+            (ToClimber.SizeSquared() > FullRateDistanceSquared || FMath::Abs(ToClimber.Z) > VerticalOcclusionHeight)};
+
+        ConnectionInfo.ReplicationPeriodFrame = bReducedRate ?
+            FMath::Max(BasePeriodFrames, ReducedRatePeriodFrames) : BasePeriodFrames;
+
+        if (bReducedRate)
+        {
+            ++Stats.NumReducedRate;
+            INC_DWORD_STAT(STAT_ClimbRepGraphReducedRate);
+        }
+    }
+}
+
+void UReplicationGraphNode_ClimbSpatialization3D::ReportStats(FOutputDevice& Ar) const
+{
+    for (const FConnectionGatherStats& Stats : LastFrameStats)
+    {
+        Ar.Logf(TEXT("  %-32s relevant %4d, reduced rate %4d, gather %.3f ms"),
+            *Stats.ConnectionName, Stats.NumRelevant, Stats.NumReducedRate, Stats.GatherSeconds * 1000.0);
+    }
+}
+
+//~ Begin UReplicationGraph Interface
+
+void UClimbingReplicationGraph::InitGlobalGraphNodes()
+{
+    Super::InitGlobalGraphNodes();
+
+    if (!CVarClimbRepGraphClimbNode.GetValueOnGameThread())
+    {
+        UE_LOG(LogTemp, Display, TEXT("%s: climb node disabled, climbers use the basic 2D grid"), *GetName());
+        return;
+    }
+
+    ClimbNode = CreateNewNode<UReplicationGraphNode_ClimbSpatialization3D>();
+    ClimbNode->CellSize = ClimbCellSize;
+    ClimbNode->FullRateDistance = ClimbFullRateDistance;
+    ClimbNode->VerticalOcclusionHeight = ClimbVerticalOcclusionHeight;
+    ClimbNode->ReducedRatePeriodFrames = ClimbReducedRatePeriodFrames;
+    AddGlobalGraphNode(ClimbNode);
+}
+
+void UClimbingReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+    if (ClimbNode && IsClimbingCharacter(ActorInfo.GetActor()))
+    {
+        ClimbNode->NotifyAddNetworkActor(ActorInfo);
+        return;
+    }
+
+    Super::RouteAddNetworkActorToNodes(ActorInfo, GlobalInfo);
+}
+
+void UClimbingReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+    if (ClimbNode && IsClimbingCharacter(ActorInfo.GetActor()))
+    {
+        ClimbNode->NotifyRemoveNetworkActor(ActorInfo);
+        return;
+    }
+
+    Super::RouteRemoveNetworkActorToNodes(ActorInfo);
+}
+
+int32 UClimbingReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+    const double ReplicateStartTime{FPlatformTime::Seconds()};
+
+    const int32 Result{Super::ServerReplicateActors(DeltaSeconds)};
+
+    ReplicateSecondsTotal += FPlatformTime::Seconds() - ReplicateStartTime;
+    ++NumReplicateFrames;
+
+    return Result;
+}
+
+//~ End UReplicationGraph Interface
+
+double UClimbingReplicationGraph::ConsumeAverageReplicateSeconds(int32& OutNumFrames)
+{
+    OutNumFrames = NumReplicateFrames;
+    const double AverageSeconds{NumReplicateFrames > 0 ? ReplicateSecondsTotal / NumReplicateFrames : 0.0};
+
+    ReplicateSecondsTotal = 0.0;
+    NumReplicateFrames = 0;
+
+    return AverageSeconds;
+}
+
+bool UClimbingReplicationGraph::IsClimbingCharacter(const AActor* Actor)
+{
+    const ACharacter* Character{Cast<ACharacter>(Actor)};
+    if (!Character || Character->bAlwaysRelevant || Character->bOnlyRelevantToOwner) return false;
+
+    return Cast<UCustomMovementComponent>(Character->GetCharacterMovement()) != nullptr;
+}
+
+// Run on a headless server (-server -nullrhi), once as is and once with -dpcvars=climb.RepGraph.ClimbNode=0
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice ClimbRepGraphReportCommand(
+    TEXT("climb.RepGraph.Report"),
+    TEXT("Reports replication time since the last report, climb node gather cost and bytes sent per connection"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(
+        [](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        UNetDriver* NetDriver{World ? World->GetNetDriver() : nullptr};
+        if (!NetDriver)
+        {
+            Ar.Log(TEXT("No net driver, run this on a server"));
+            return;
+        }
+
+        UClimbingReplicationGraph* Graph{Cast<UClimbingReplicationGraph>(NetDriver->GetReplicationDriver())};
+        if (!Graph)
+        {
+            Ar.Log(TEXT("UClimbingReplicationGraph is not the active replication driver"));
+            return;
+        }
+
+        int32 NumFrames{0};
+        const double ReplicateSeconds{Graph->ConsumeAverageReplicateSeconds(NumFrames)};
+
+        Ar.Logf(TEXT("Climb replication graph (%s), replicate avg %.3f ms over %d frames"),
+            Graph->GetClimbNode() ? TEXT("climb node") : TEXT("basic grid only"), ReplicateSeconds * 1000.0, NumFrames);
+
+        if (Graph->GetClimbNode())
+        {
+            Ar.Log(TEXT("Climb node, last frame:"));
+            Graph->GetClimbNode()->ReportStats(Ar);
+        }
+
+        for (const UNetConnection* Connection : NetDriver->ClientConnections)
+        {
+            if (!Connection) continue;
+
+            Ar.Logf(TEXT("  %-32s out %6d bytes/s, %4d channels"),
+                *Connection->GetName(), Connection->OutBytesPerSecond, Connection->OpenChannels.Num());
+        }
+    }));
@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ClimbingSystemCollision.h"
+#include "ClimbSurfaceMath.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+namespace ClimbingSystemCollision
+{
+    bool IsClimbableCandidate(const UPrimitiveComponent* Component, float MinHeight)
+    {
+        if (!Component ||
+            !Component->IsRegistered() ||
+            Component->Mobility == EComponentMobility::Movable ||
+            !Component->IsQueryCollisionEnabled() ||
+            Component->GetCollisionResponseToChannel(ECC_Pawn) != ECR_Block)
+        {
+            return false;
+        }
+
+        const FBox Bounds{Component->Bounds.GetBox()};
+        if (Bounds.GetSize().Z < MinHeight) return false;
+
+        const FVector Center{Bounds.GetCenter()};
+        const FVector Extent{Bounds.GetExtent()};
+        const FCollisionQueryParams QueryParams{SCENE_QUERY_STAT(ClimbTagClimbable), false};
+
+        // One ray into each side at mid height, any wall steep enough to climb qualifies
+        for (const FVector& Direction : {FVector::ForwardVector, FVector::BackwardVector, FVector::RightVector, FVector::LeftVector})
+        {
+            const FVector Start{Center - Direction * (Extent.GetAbsMax() + 10.f)};
+
+            FHitResult Hit;
+            if (Component->LineTraceComponent(Hit, Start, Center, QueryParams) &&
+                Hit.ImpactNormal.Z < ClimbSurfaceMath::StopAngleCos)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    const UInstancedStaticMeshComponent* GetClimbDataInstancedComponent(const UPrimitiveComponent* Component)
+    {
+        const UInstancedStaticMeshComponent* InstancedComponent{Cast<UInstancedStaticMeshComponent>(Component)};
+
+        return InstancedComponent && InstancedComponent->NumCustomDataFloats >= NumInstanceClimbDataFloats &&
+            InstancedComponent->ComponentHasTag(ClimbInstanceDataTag) ? InstancedComponent : nullptr;
+    }
+
+    bool GetInstanceClimbData(const UInstancedStaticMeshComponent* Component, int32 InstanceIndex,
+        FClimbInstanceData& OutData)
+    {
+        OutData = FClimbInstanceData();
+
+        if (!Component || InstanceIndex < 0) return false;
+
+        const int32 NumFloats{Component->NumCustomDataFloats};
+        const int32 DataIndex{InstanceIndex * NumFloats + NumFloats - NumInstanceClimbDataFloats};
+        if (NumFloats < NumInstanceClimbDataFloats || !Component->PerInstanceSMCustomData.IsValidIndex(DataIndex + 2)) return false;
+
+        const float* Data{&Component->PerInstanceSMCustomData[DataIndex]};
+
+        // Zeroed multipliers mean the instance keeps its material's properties
+        OutData.Flags = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt32(Data[0]), 0, 255));
+        OutData.SpeedScale = Data[1] > 0.f ? Data[1] : 1.f;
+        OutData.Grip = Data[2] > 0.f ? Data[2] : 1.f;
+
+        return true;
+    }
+
+    bool IsClimbableHit(const FHitResult& Hit)
+    {
+        FClimbInstanceData InstanceData;
+        GetInstanceClimbData(GetClimbDataInstancedComponent(Hit.GetComponent()), Hit.Item, InstanceData);
+
+        return InstanceData.IsClimbable();
+    }
+
+    bool SetInstanceClimbData(UInstancedStaticMeshComponent* Component, int32 InstanceIndex,
+        const FClimbInstanceData& Data, bool bMarkRenderStateDirty)
+    {
+        if (!Component || Component->NumCustomDataFloats < NumInstanceClimbDataFloats) return false;
+
+        const int32 FirstDataIndex{Component->NumCustomDataFloats - NumInstanceClimbDataFloats};
+
+        // Only the last write refreshes the render state
+        const bool bWritten{
+            Component->SetCustomDataValue(InstanceIndex, FirstDataIndex, Data.Flags, false) &&
+            Component->SetCustomDataValue(InstanceIndex, FirstDataIndex + 1, Data.SpeedScale, false) &&
+            Component->SetCustomDataValue(InstanceIndex, FirstDataIndex + 2, Data.Grip, bMarkRenderStateDirty)};
+
+        if (bWritten)
+        {
+            Component->ComponentTags.AddUnique(ClimbInstanceDataTag);
+        }
+
+        return bWritten;
+    }
+
+#if WITH_EDITOR
+    static void TagClimbable(const TArray<FString>& Args, UWorld* World)
+    {
+        if (!World) return;
+
+        const bool bUntag{Args.Contains(TEXT("Untag"))};
+        const float MinHeight{Args.Num() > 0 && !bUntag ? FCString::Atof(*Args[0]) : 150.f};
+
+        int32 NumTagged{0};
+        int32 NumUntagged{0};
+
+        for (TObjectIterator<UStaticMeshComponent> It; It; ++It)
+        {
+            UStaticMeshComponent* Component{*It};
+            if (Component->GetWorld() != World) continue;
+
+            const ECollisionResponse Response{bUntag || !IsClimbableCandidate(Component, MinHeight) ? ECR_Ignore : ECR_Block};
+            if (Component->GetCollisionResponseToChannel(ECC_Climbable) == Response) continue;
+
+            // Only the one response changes, the rest of the component's collision setup is kept
+            Component->Modify();
+            Component->SetCollisionResponseToChannel(ECC_Climbable, Response);
+            ++(Response == ECR_Block ? NumTagged : NumUntagged);
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("climb.TagClimbable: %d static mesh components tagged climbable, %d untagged"),
+            NumTagged, NumUntagged);
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs TagClimbableCommand(
+        TEXT("climb.TagClimbable"),
+        TEXT("Makes the static meshes of the world that look climbable block the Climbable channel, and the others ignore it. ")
+        TEXT("Usage: climb.TagClimbable [MinHeight=150] | climb.TagClimbable Untag"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&TagClimbable));
+#endif
+}
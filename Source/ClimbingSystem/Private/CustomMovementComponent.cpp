@@ -1,529 +1,2207 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-
-#include "CustomMovementComponent.h"
-#include "Kismet/KismetSystemLibrary.h"
-#include "Components/CapsuleComponent.h"
-#include "ClimbingSystem/ClimbingSystemCharacter.h"
-#include "Kismet/KismetMathLibrary.h"
-#include "ClimbingSystem/DebugHelper.h"
-
-//~ Begin UCharacterMovementComponent Interface
-
-void  UCustomMovementComponent::BeginPlay()
-{
-    Super::BeginPlay();
-
-    OwningPlayerAnimInstance = CharacterOwner->GetMesh()->GetAnimInstance();
-
-    if (OwningPlayerAnimInstance)
-    {
-        OwningPlayerAnimInstance->OnMontageEnded.AddDynamic(
-            this, 
-            &UCustomMovementComponent::OnClimbMontageEnded
-        );
-
-        OwningPlayerAnimInstance->OnMontageBlendingOut.AddDynamic(
-            this,
-            &UCustomMovementComponent::OnClimbMontageEnded
-        );
-    }
-}
-
-void UCustomMovementComponent::TickComponent(
-    float DeltaTime, 
-    enum ELevelTick TickType, 
-    FActorComponentTickFunction* ThisTickFunction)
-{
-    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-    // Core climbing detection update
-   /* TraceClimbaleSurface();
-    TraceFromEyeHeight(100.f);*/
-    //CanClimbDownLedge();
-}
-
-// Called after very time movement mode changed
-void UCustomMovementComponent::OnMovementModeChanged(
-    EMovementMode PreviousMovementMode, 
-    uint8 PreviousCustomMode)
-{
-    //// Transition TO climbing state
-    if (IsClimbing())
-    {
-        bOrientRotationToMovement = false;
-        CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(48.f);
-    }
-
-    // Transition FROM climbing state
-    if (PreviousMovementMode == MOVE_Custom && 
-        PreviousCustomMode == ECustomMovementMode::MOVE_Climb)
-    {
-        bOrientRotationToMovement = true;
-        CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(90.f);
-
-        const FRotator DirtyRotation = UpdatedComponent->GetComponentRotation();
-        const FRotator CleanStandRotation = FRotator(0.f, DirtyRotation.Yaw, 0.f);
-        UpdatedComponent->SetRelativeRotation(CleanStandRotation);
-
-        StopMovementImmediately();
-    }
-
-    Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
-}
-
-void UCustomMovementComponent::PhysCustom(float deltaTime, int32 Iterations)
-{
-    if (IsClimbing())
-    {
-        // Set up the custom physics
-        PhysClimb(deltaTime, Iterations);
-    }
-
-    Super::PhysCustom(deltaTime, Iterations);
-}
-
-float UCustomMovementComponent::GetMaxSpeed() const
-{
-    if (IsClimbing())
-    {
-        return MaxClimbSpeed;
-    }
-    else
-    {
-        return Super::GetMaxSpeed();
-    }
-}
-
-float UCustomMovementComponent::GetMaxAcceleration() const
-{
-    if (IsClimbing())
-    {
-        return MaxClimbAcceleration;
-    }
-    else
-    {
-        return Super::GetMaxAcceleration();
-    }
-}
-
-FVector UCustomMovementComponent::ConstrainAnimRootMotionVelocity(const FVector& RootMotionVelocity,
-    const FVector& CurrentVelocity) const
-{
-    const bool bIsPlayRMMontage{IsFalling() && 
-        OwningPlayerAnimInstance && 
-        OwningPlayerAnimInstance->IsAnyMontagePlaying()};
-
-    if (bIsPlayRMMontage)
-    {
-        return RootMotionVelocity;
-    }
-	else
-    {
-        return Super::ConstrainAnimRootMotionVelocity(RootMotionVelocity, CurrentVelocity);
-    }
-}
-
-//~ End UCharacterMovementComponent Interface
-
-void UCustomMovementComponent::ToggleToClimbing(bool bEnableClimb)
-{
-    if (bEnableClimb)
-    {
-        if (CanStartClimbing())
-        {
-            // Enter the climb state
-            //Debug::Print(TEXT("Start Climbing..."), FColor::Green, 3);
-            PlayClimbMontage(IdleToClimbMontage);
-        }else
-        {
-            if (CanClimbDownLedge())
-            {
-                PlayClimbMontage(ClimbDownLedgeMontage);
-                CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(40.f);
-            }else
-            {
-                Debug::Print(TEXT("Cannot Climb Down the Ledge"), FColor::Red, 1);
-            }
-        }
-    }
-    else
-    {
-        // Stop climbing
-        //Debug::Print(TEXT("StopClimbing..."), FColor::Green, 3);
-        StopClimbing();
-    }
-}
-
-// To check if we are in the state of climbing or not
-bool UCustomMovementComponent::IsClimbing() const
-{
-    return MovementMode == MOVE_Custom && CustomMovementMode ==
-        ECustomMovementMode::MOVE_Climb;
-}
-
-
-#pragma region ClimbTraces
-// Get all objects in fron of character and out it in to an array and return this array.
-TArray<FHitResult> UCustomMovementComponent::DoCapsuleTraceMultiByObject(
-    const FVector& Start, 
-    const FVector& End, 
-    bool bShowDebugShape,
-    bool bDrawPresistantShapes)
-{
-    EDrawDebugTrace::Type DebugType{EDrawDebugTrace::None};
-
-    if (bShowDebugShape)
-    {
-        DebugType = EDrawDebugTrace::ForOneFrame;
-        if (bDrawPresistantShapes)
-        {
-            DebugType = EDrawDebugTrace::Persistent;
-        }
-    }
-
-    TArray<FHitResult> OutCapsuleTraceHitArry;
-    UKismetSystemLibrary::CapsuleTraceMultiForObjects(
-        this,
-        Start,
-        End,
-        ClimbCapsuleTraceRadius,
-        ClimbCapsuleTraceHalfHeight,
-        ClimbableSurfaceTraceTypes,
-        false,
-        TArray<AActor*>(),
-        DebugType,
-        OutCapsuleTraceHitArry,
-        false
-    );
-
-    return OutCapsuleTraceHitArry;
-}
-
-FHitResult UCustomMovementComponent::DoLineTraceSingleByObject(
-    const FVector& Start, 
-    const FVector& End, 
-    bool bShowDebugShape,
-    bool bDrawPresistantShapes)
-{
-    EDrawDebugTrace::Type DebugType{EDrawDebugTrace::None};
-
-    if (bShowDebugShape)
-    {
-        DebugType = EDrawDebugTrace::ForOneFrame;
-        if (bDrawPresistantShapes)
-        {
-            DebugType = EDrawDebugTrace::Persistent;
-        }
-    }
-    FHitResult Out;
-
-    UKismetSystemLibrary::LineTraceSingleForObjects(
-        this,
-        Start,
-        End,
-        ClimbableSurfaceTraceTypes,
-        false,
-        TArray<AActor*>(),
-        DebugType,
-        Out,
-        false
-    );
-    return Out;
-}
-
-#pragma endregion
-
-#pragma region ClimbCore
-// Core method for tracing surfaces,return true if near a climbable surface
-bool UCustomMovementComponent::TraceClimbaleSurface()
-{
-    // Offset start position to prevent self-collision
-    const FVector StartOffset{UpdatedComponent->GetForwardVector() * 30.f};
-    const FVector Start{UpdatedComponent->GetComponentLocation() + StartOffset};
-    const FVector End{Start + UpdatedComponent->GetForwardVector()};
-
-    // Create capsule to detect climble suefaces in front
-    ClimbableSurfacesTraceResults = DoCapsuleTraceMultiByObject(Start, End, false);
-
-    return !ClimbableSurfacesTraceResults.IsEmpty();
-}
-
-FHitResult UCustomMovementComponent::TraceFromEyeHeight(
-    float TraceDistance,
-    float TraceStartOffset)
-{
-    // Calculate start position at character eye
-    const FVector HeightOffset{UpdatedComponent->GetUpVector() *
-        (TraceStartOffset + CharacterOwner->BaseEyeHeight)};
-
-    const FVector Start{UpdatedComponent->GetComponentLocation() +
-        HeightOffset};
-    const FVector End{Start + UpdatedComponent->GetForwardVector() *
-        TraceDistance};
-
-    // Create line trace to detect surface
-    return DoLineTraceSingleByObject(Start, End, true);
-}
-
-// To check if player can climb, return true if yes
-bool UCustomMovementComponent::CanStartClimbing()
-{
-    // Must be on ground and facing climbale surface
-    if (IsFalling()) return false;
-    if (!TraceClimbaleSurface()) return false;
-
-    //Must have overhead clearance
-    if (!TraceFromEyeHeight(90.f).bBlockingHit) return false;
-
-    return true;
-}
-
-bool UCustomMovementComponent::CanClimbDownLedge()
-{
-    if (IsFalling()) return false;
-
-    const FVector ComponentLocation{UpdatedComponent->GetComponentLocation()};
-    const FVector ComponentForwardVector{UpdatedComponent->GetForwardVector()};
-    const FVector DownVector{-UpdatedComponent->GetUpVector()};
-
-    const FVector WalkableSurfaceTraceStart{ComponentLocation + ComponentForwardVector * ClimbDownSurfaceTraceOffset};
-    const FVector WalkableSurfaceTraceEnd{WalkableSurfaceTraceStart + DownVector * 100.f};
-
-    FHitResult WalkableSurfaseHit{DoLineTraceSingleByObject(WalkableSurfaceTraceStart, WalkableSurfaceTraceEnd, true)};
-
-    const FVector LedgeTraceStart{WalkableSurfaseHit.TraceStart + ComponentForwardVector * ClimbDownLedgeSurfaceTraceOffset};
-    const FVector LedgeTraceEnd{LedgeTraceStart + DownVector * 200.f};
-
-    FHitResult LedgeTraceHit = DoLineTraceSingleByObject(LedgeTraceStart, LedgeTraceEnd, true);
-
-    if (WalkableSurfaseHit.bBlockingHit && !LedgeTraceHit.bBlockingHit) return true;
-
-    return false;
-}
-
-void UCustomMovementComponent::StartClimbing()
-{
-    SetMovementMode(MOVE_Custom,ECustomMovementMode::MOVE_Climb);
-}
-
-void UCustomMovementComponent::StopClimbing()
-{
-    SetMovementMode(MOVE_Falling);
-}
-
-void UCustomMovementComponent::PhysClimb(float deltaTime, int32 Iterations)
-{
-    if (deltaTime < MIN_TICK_TIME)
-    {
-        return;
-    }
-
-    /** Process all the climbable surfaces info */
-    TraceClimbaleSurface();
-    ProcessClimbaleSurfaceInfo();
-
-    if (CheckHasReachedFloor())
-    {
-        Debug::Print(TEXT("HasReachedFloor..."), FColor::Green, 2);
-    }else
-    {
-        Debug::Print(TEXT("HasNotReachedFloor..."), FColor::Red, 2);
-    }
-
-    // Check if we should stop climbing
-    if (CheckShouldStopClimbing())
-    {
-        StopClimbing();
-    }
-
-    RestorePreAdditiveRootMotionVelocity();
-
-    if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
-    {
-    // Define the max speed and acceleration
-        CalcVelocity(deltaTime, 0.f, true, MaxBreakClimbDeceleration);
-    }
-
-    ApplyRootMotionToVelocity(deltaTime);
-
-    FVector OldLocation = UpdatedComponent->GetComponentLocation();
-    const FVector Adjusted = Velocity * deltaTime;
-    FHitResult Hit(1.f);
-
-    /** Handle climb rotation */
-    SafeMoveUpdatedComponent(Adjusted, GetClimbRotation(deltaTime), true, Hit);
-
-    if (Hit.Time < 1.f)
-    {
-        //adjust and try again
-        HandleImpact(Hit, deltaTime, Adjusted);
-        SlideAlongSurface(Adjusted, (1.f - Hit.Time), Hit.Normal, Hit, true);
-    }
-
-    if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
-    {
-        Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / deltaTime;
-    }
-
-    /** Snap to climbable surface */
-    SnapMovementToClimbableSurfaces(deltaTime);
-
-    if (CheckHasReachedLedge())
-    {
-        Debug::Print(TEXT("HasReachedLedge"), FColor::Green, 1);
-        PlayClimbMontage(ClimbToTopMontage);
-    }else
-    {
-        Debug::Print(TEXT("HasNotReachedLedge"), FColor::Red, 1);
-    }
-}
-
-void UCustomMovementComponent::ProcessClimbaleSurfaceInfo()
-{
-    CurrentClimbableSurfaceLocation = FVector::ZeroVector;
-    CurrentClimbableSurfaceNormal = FVector::ZeroVector;
-
-    if (ClimbableSurfacesTraceResults.IsEmpty()) return;
-
-    for (const FHitResult& TraceHitResult : ClimbableSurfacesTraceResults)
-    {
-        CurrentClimbableSurfaceLocation += TraceHitResult.ImpactPoint;
-        CurrentClimbableSurfaceNormal += TraceHitResult.ImpactNormal;
-    }
-
-    CurrentClimbableSurfaceLocation /= ClimbableSurfacesTraceResults.Num();
-    CurrentClimbableSurfaceNormal = CurrentClimbableSurfaceNormal.GetSafeNormal();
-}
-
-bool UCustomMovementComponent::CheckShouldStopClimbing()
-{
-    if (ClimbableSurfacesTraceResults.IsEmpty()) return true;
-
-    const float DotProductOfUpVectorAndSurfaceNormal{
-        static_cast<float>(FVector::DotProduct(CurrentClimbableSurfaceNormal,
-            FVector::UpVector))};
-
-    const float Degree{FMath::RadiansToDegrees(
-        FMath::Acos(DotProductOfUpVectorAndSurfaceNormal))};
-
-    if (Degree <= 60.f) return true;
-
-    Debug::Print(TEXT("Degree of Climb Surface: ") + FString::SanitizeFloat(Degree),FColor::Yellow,1);
-
-    return false;
-}
-
-bool UCustomMovementComponent::CheckHasReachedFloor()
-{
-    // If Character is Climbing Up,means he is not going to reach floor.
-    if (GetUnrotatedClimbVelocity().Z > 10.f) return false;
-
-    const FVector DownVector{-UpdatedComponent->GetUpVector()};
-    const FVector StartOffset{DownVector * 50.f};
-
-    const FVector Start{UpdatedComponent->GetComponentLocation() + StartOffset};
-    const FVector End{Start + DownVector};
-
-    TArray<FHitResult> PossibleFloorHits{
-        DoCapsuleTraceMultiByObject(Start, End, true)};
-
-    if (PossibleFloorHits.IsEmpty()) return false;
-
-    for (const FHitResult& PossibleFloorHit : PossibleFloorHits)
-    {
-        const bool bFloorReached = FVector::Parallel(
-            -PossibleFloorHit.ImpactNormal, FVector::UpVector) &&
-            GetUnrotatedClimbVelocity().Z < -10.f;
-
-        if (bFloorReached)
-        {
-            return true;
-        }
-    }
-    return false;
-}
-
-bool UCustomMovementComponent::CheckHasReachedLedge()
-{
-    FHitResult LedgeHitResult = 
-        TraceFromEyeHeight(100.f, 50.f);
-
-    if (!LedgeHitResult.bBlockingHit)
-    {
-        const FVector WalkableSurfaceTraceStart{LedgeHitResult.TraceEnd};
-
-        const FVector DownVector{-UpdatedComponent->GetUpVector()};
-        const FVector WalkableSurfaceTraceEnd{WalkableSurfaceTraceStart + DownVector * 100.f};
-        FHitResult WalkableSurfaceHitResult =
-            DoLineTraceSingleByObject(WalkableSurfaceTraceStart, WalkableSurfaceTraceEnd, true);
-
-        if (WalkableSurfaceHitResult.bBlockingHit && GetUnrotatedClimbVelocity().Z > 10.f)
-        {
-            return true;
-        }
-    }
-
-    return false;
-}
-
-FQuat UCustomMovementComponent::GetClimbRotation(float DeltaTime)
-{
-    const FQuat CurrentQuat{UpdatedComponent->GetComponentQuat()};
-    
-    if (HasAnimRootMotion() || CurrentRootMotion.HasOverrideVelocity())
-    {
-        return CurrentQuat;
-    }
-
-    FQuat TargetQuat{FRotationMatrix::MakeFromX(-CurrentClimbableSurfaceNormal).ToQuat()};
-
-    return FMath::QInterpTo(CurrentQuat, TargetQuat, DeltaTime, 5.f);
-}
-
-void UCustomMovementComponent::SnapMovementToClimbableSurfaces(float DeltaTime)
-{
-    const FVector ComponentLocation{UpdatedComponent->GetComponentLocation()};
-    const FVector ComponentFowrard{UpdatedComponent->GetForwardVector()};
-
-    const FVector ProjectedCharacterToSurface{
-        (CurrentClimbableSurfaceLocation - ComponentLocation).ProjectOnTo(ComponentFowrard)
-    };
-
-    const FVector SnapVector{-CurrentClimbableSurfaceNormal * 
-        ProjectedCharacterToSurface.Length()};
-
-    UpdatedComponent->MoveComponent(
-        SnapVector * DeltaTime * MaxClimbSpeed,
-        UpdatedComponent->GetComponentQuat(),
-        true);
-}
-
-void UCustomMovementComponent::PlayClimbMontage(UAnimMontage* MontageToPlay)
-{
-    if (!MontageToPlay) return;
-    if (!OwningPlayerAnimInstance) return;
-    if (OwningPlayerAnimInstance->IsAnyMontagePlaying()) return;
-
-    OwningPlayerAnimInstance->Montage_Play(MontageToPlay);
-}
-
-void UCustomMovementComponent::OnClimbMontageEnded(UAnimMontage* Montage, bool bInterrupted)
-{
-    Debug::Print(TEXT("Climb Montage Ended..."));
-    if (Montage == IdleToClimbMontage || Montage == ClimbDownLedgeMontage)
-    {
-        StartClimbing();
-        StopMovementImmediately();
-    }
-    if (Montage == ClimbToTopMontage)
-    {
-        SetMovementMode(MOVE_Walking);
-    }
-}
-
-FVector UCustomMovementComponent::GetUnrotatedClimbVelocity() const
-{
-    return UKismetMathLibrary::Quat_UnrotateVector(UpdatedComponent->GetComponentQuat(), Velocity);
-}
-#pragma endregion
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CustomMovementComponent.h"
+#include "DrawDebugHelpers.h"
+#include "Components/CapsuleComponent.h"
+#include "Animation/AnimMontage.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "ClimbingSystem/DebugHelper.h"
+#include "ClimbQueryBudgetSubsystem.h"
+#include "ClimbingSystemStats.h"
+#include "UObject/UObjectIterator.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "ClimbRootMotionTable.h"
+#include "ClimbSurfaceMath.h"
+#include "ClimbSavedMove.h"
+#include "ClimbSurfacePhysicalMaterial.h"
+#include "ClimbingSystemCollision.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
+#include "LandscapeHeightfieldCollisionComponent.h"
+
+static TAutoConsoleVariable<int32> CVarClimbTelemetryCapacity(
+    TEXT("climb.Telemetry.Capacity"),
+    256,
+    TEXT("Climb updates kept in each climber's telemetry ring buffer, applied on BeginPlay. 0 disables recording."));
+
+static TAutoConsoleVariable<int32> CVarClimbBakedRootMotion(
+    TEXT("climb.BakedRootMotion"),
+    1,
+    TEXT("Play climb transitions from baked root motion tables. 0: never, 1: networked games, on the server and the clients alike, 2: everywhere."));
+
+static TAutoConsoleVariable<bool> CVarClimbAdaptiveSubsteps(
+    TEXT("climb.AdaptiveSubsteps"),
+    true,
+    TEXT("Move climbers in adaptive substeps that sweep the move and the surface snap together. ")
+    TEXT("Off moves once per update and snaps with a second sweep, compare with \"stat Climbing\"."));
+
+#if ENABLE_DRAW_DEBUG
+static TAutoConsoleVariable<bool> CVarClimbTelemetryDraw(
+    TEXT("climb.Telemetry.Draw"),
+    false,
+    TEXT("Draw the recorded climb telemetry of every climber."));
+#endif
+
+UCustomMovementComponent::UCustomMovementComponent(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    SetMoveResponseDataContainer(ClimbMoveResponseDataContainer);
+}
+
+//~ Begin UCharacterMovementComponent Interface
+
+void  UCustomMovementComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    LLM_SCOPE_BYTAG(ClimbingSystem);
+
+    ClimbTelemetry.Initialize(CVarClimbTelemetryCapacity.GetValueOnGameThread());
+
+    // Spread the proximity checks of many characters over different frames
+    ClimbMontagePreloadCheckTimer = FMath::FRand() * ClimbMontagePreloadCheckInterval;
+
+    OwningPlayerAnimInstance = CharacterOwner->GetMesh()->GetAnimInstance();
+
+    if (OwningPlayerAnimInstance)
+    {
+        OwningPlayerAnimInstance->OnMontageEnded.AddDynamic(
+            this, 
+            &UCustomMovementComponent::OnClimbMontageEnded
+        );
+
+        OwningPlayerAnimInstance->OnMontageBlendingOut.AddDynamic(
+            this,
+            &UCustomMovementComponent::OnClimbMontageEnded
+        );
+    }
+
+    ClimbQueryBudget = GetWorld()->GetSubsystem<UClimbQueryBudgetSubsystem>();
+    if (ClimbQueryBudget)
+    {
+        ClimbQueryBudget->RegisterClimber(this);
+    }
+
+    if (bRaiseClimbStreamingSource && GetWorld()->IsPartitionedWorld())
+    {
+        if (UWorldPartitionSubsystem* WorldPartitionSubsystem = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>())
+        {
+            ClimbStreamingSourceName = FName(*FString::Printf(TEXT("%s_Climb"), *CharacterOwner->GetName()));
+            WorldPartitionSubsystem->RegisterStreamingSourceProvider(this);
+            bClimbStreamingSourceRegistered = true;
+        }
+    }
+
+    // Nothing renders on a dedicated server, with every transition baked the pose never needs to tick
+    if (IsNetMode(NM_DedicatedServer) && ShouldUseBakedClimbRootMotion())
+    {
+        bool bAllMontagesBaked{true};
+        for (const TSoftObjectPtr<UAnimMontage>* Montage : {&IdleToClimbMontage, &ClimbToTopMontage, &ClimbDownLedgeMontage})
+        {
+            bAllMontagesBaked &= Montage->IsNull() || ClimbRootMotionTable->FindTrack(*Montage) != nullptr;
+        }
+
+        if (bAllMontagesBaked)
+        {
+            CharacterOwner->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("%s: %s is missing climb montages, the server keeps ticking animation"),
+                *GetNameSafe(CharacterOwner), *GetNameSafe(ClimbRootMotionTable));
+        }
+    }
+}
+
+void UCustomMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (ClimbQueryBudget)
+    {
+        ClimbQueryBudget->UnregisterClimber(this);
+        ClimbQueryBudget = nullptr;
+    }
+
+    if (bClimbStreamingSourceRegistered)
+    {
+        if (UWorldPartitionSubsystem* WorldPartitionSubsystem = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>())
+        {
+            WorldPartitionSubsystem->UnregisterStreamingSourceProvider(this);
+        }
+        bClimbStreamingSourceRegistered = false;
+    }
+
+    if (ClimbMontageLoadHandle.IsValid())
+    {
+        ClimbMontageLoadHandle->CancelHandle();
+        ClimbMontageLoadHandle.Reset();
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UCustomMovementComponent::TickComponent(
+    float DeltaTime, 
+    enum ELevelTick TickType, 
+    FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+#if ENABLE_DRAW_DEBUG
+    if (CVarClimbTelemetryDraw.GetValueOnGameThread())
+    {
+        ClimbTelemetryRenderer.Draw(GetWorld(), ClimbTelemetry);
+    }
+#endif
+
+    UpdateBakedClimbRootMotion();
+
+    UpdateSimulatedClimbSurface(DeltaTime);
+
+    PublishClimbSurfacePatch();
+
+    UpdateClimbProximity(DeltaTime);
+
+    UpdateClimbIntent(DeltaTime);
+
+    UpdateAutoClimbTraversal(DeltaTime);
+}
+
+// Called after very time movement mode changed
+void UCustomMovementComponent::OnMovementModeChanged(
+    EMovementMode PreviousMovementMode, 
+    uint8 PreviousCustomMode)
+{
+    const bool bWasInClimbTraversal{PreviousMovementMode == MOVE_Custom &&
+        PreviousCustomMode < ECustomMovementMode::MOVE_MAX};
+
+    //// Transition TO climbing state
+    if (IsInClimbTraversal())
+    {
+        bOrientRotationToMovement = false;
+
+        // Wall runs keep the standing capsule, everything else hugs the wall
+        CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(IsWallRunning() ? 90.f : 48.f);
+
+        RefreshClimbFrame();
+
+        if (!bWasInClimbTraversal)
+        {
+            // Results from before the montage are stale, force a fresh probe on the first climb update
+            ClimbableSurfacesTraceResults.Reset();
+            CurrentClimbableSurface = FClimbSurfaceInfo();
+            CurrentClimbSurfaceProperties = FClimbSurfaceProperties();
+            RefreshClimbSurfaceFrame();
+
+            bClimbSurfaceStreaming = false;
+            bHoldingForClimbStreaming = false;
+            ClimbStreamingHoldTime = 0.f;
+        }
+    }
+
+    // Transition FROM climbing state
+    else if (bWasInClimbTraversal)
+    {
+        bOrientRotationToMovement = true;
+        CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(90.f);
+
+        const FRotator DirtyRotation = UpdatedComponent->GetComponentRotation();
+        const FRotator CleanStandRotation = FRotator(0.f, DirtyRotation.Yaw, 0.f);
+        UpdatedComponent->SetRelativeRotation(CleanStandRotation);
+
+        // Wall runs hand their momentum over to falling
+        if (PreviousCustomMode != ECustomMovementMode::MOVE_WallRun)
+        {
+            StopMovementImmediately();
+        }
+    }
+
+    if (!IsWallRunning())
+    {
+        WallRunSide = 0.f;
+    }
+
+    if (IsInClimbTraversal() != bWasInClimbTraversal)
+    {
+        ++NumClimbTraversalChanges;
+    }
+
+    if (IsInClimbTraversal() || bWasInClimbTraversal)
+    {
+        FClimbTelemetryFrame TransitionFrame;
+        TransitionFrame.Flags = EClimbTelemetryFlags::ModeChanged;
+        TransitionFrame.PreviousMovementMode = PreviousMovementMode;
+        TransitionFrame.PreviousCustomMovementMode = PreviousCustomMode;
+        CommitClimbTelemetry(TransitionFrame);
+    }
+
+    Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+}
+
+const UCustomMovementComponent::FPhysCustomModeFunc
+    UCustomMovementComponent::PhysCustomModeTable[ECustomMovementMode::MOVE_MAX]
+{
+    &UCustomMovementComponent::PhysClimb,       // MOVE_Climb
+    &UCustomMovementComponent::PhysLedgeHang,   // MOVE_LedgeHang
+    &UCustomMovementComponent::PhysClimbHop,    // MOVE_ClimbHop
+    &UCustomMovementComponent::PhysWallRun,     // MOVE_WallRun
+};
+
+void UCustomMovementComponent::PhysCustom(float deltaTime, int32 Iterations)
+{
+    if (IsInClimbTraversal())
+    {
+        PendingClimbTelemetry = FClimbTelemetryFrame();
+
+        // Set up the custom physics
+        (this->*PhysCustomModeTable[CustomMovementMode])(deltaTime, Iterations);
+
+        CommitClimbTelemetry(PendingClimbTelemetry);
+    }
+
+    Super::PhysCustom(deltaTime, Iterations);
+}
+
+float UCustomMovementComponent::GetMaxSpeed() const
+{
+    if (IsClimbing() || CustomMovementMode == ECustomMovementMode::MOVE_ClimbHop)
+    {
+        return MaxClimbSpeed * CurrentClimbSurfaceProperties.SpeedScale;
+    }
+    else if (IsLedgeHanging())
+    {
+        return MaxLedgeShimmySpeed;
+    }
+    else if (IsWallRunning())
+    {
+        return MaxWallRunSpeed;
+    }
+    else
+    {
+        return Super::GetMaxSpeed();
+    }
+}
+
+float UCustomMovementComponent::GetMaxAcceleration() const
+{
+    if (IsInClimbTraversal())
+    {
+        return MaxClimbAcceleration * CurrentClimbSurfaceProperties.Grip;
+    }
+    else
+    {
+        return Super::GetMaxAcceleration();
+    }
+}
+
+FVector UCustomMovementComponent::ConstrainAnimRootMotionVelocity(const FVector& RootMotionVelocity,
+    const FVector& CurrentVelocity) const
+{
+    const bool bIsPlayRMMontage{IsFalling() && 
+        OwningPlayerAnimInstance && 
+        OwningPlayerAnimInstance->IsAnyMontagePlaying()};
+
+    if (bIsPlayRMMontage)
+    {
+        return RootMotionVelocity;
+    }
+	else
+    {
+        return Super::ConstrainAnimRootMotionVelocity(RootMotionVelocity, CurrentVelocity);
+    }
+}
+
+bool UCustomMovementComponent::ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel,
+    const FVector& ClientWorldLocation, const FVector& RelativeClientLocation,
+    UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode)
+{
+    const bool bNeedsCorrection{Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel,
+        ClientWorldLocation, RelativeClientLocation, ClientMovementBase, ClientBaseBoneName, ClientMovementMode)};
+
+    if (bNeedsCorrection)
+    {
+        ++NumClientCorrections;
+        INC_DWORD_STAT(STAT_ClimbClientCorrections);
+    }
+
+    return bNeedsCorrection;
+}
+
+void UCustomMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
+{
+    Super::UpdateFromCompressedFlags(Flags);
+
+    bWantsAutoMantle = (Flags & FSavedMove_Character::FLAG_Custom_0) != 0;
+    bWantsAutoLedgeGrab = (Flags & FSavedMove_Character::FLAG_Custom_1) != 0;
+    bWantsClimbJump = (Flags & FSavedMove_Character::FLAG_Custom_2) != 0;
+}
+
+void UCustomMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+    Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+    PerformClimbJump();
+    PerformAutoClimbTraversal();
+}
+
+void UCustomMovementComponent::ClientHandleMoveResponse(const FCharacterMoveResponseDataContainer& MoveResponse)
+{
+    Super::ClientHandleMoveResponse(MoveResponse);
+
+    // After the adjustment, so the corrected movement mode is already in place
+    if (MoveResponse.IsCorrection())
+    {
+        ApplyClimbStateSnapshot(static_cast<const FClimbMoveResponseDataContainer&>(MoveResponse).ClimbState);
+    }
+}
+
+bool UCustomMovementComponent::ClientUpdatePositionAfterServerUpdate()
+{
+    // Replayed moves set and consume their own requests, keep the ones waiting for the next move
+    const bool bPendingAutoMantle{bWantsAutoMantle};
+    const bool bPendingAutoLedgeGrab{bWantsAutoLedgeGrab};
+    const bool bPendingClimbJump{bWantsClimbJump};
+
+    const bool bResult{Super::ClientUpdatePositionAfterServerUpdate()};
+
+    bWantsAutoMantle = bPendingAutoMantle;
+    bWantsAutoLedgeGrab = bPendingAutoLedgeGrab;
+    bWantsClimbJump = bPendingClimbJump;
+
+    // The view points into saved moves, which may be freed from here on
+    ReplayedClimbProbes = TConstArrayView<FClimbProbeRecord>();
+    NextReplayedClimbProbe = 0;
+
+    return bResult;
+}
+
+FNetworkPredictionData_Client* UCustomMovementComponent::GetPredictionData_Client() const
+{
+    if (!ClientPredictionData)
+    {
+        UCustomMovementComponent* MutableThis{const_cast<UCustomMovementComponent*>(this)};
+        MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_Climb(*this);
+    }
+
+    return ClientPredictionData;
+}
+
+void UCustomMovementComponent::StopMovementImmediately()
+{
+    Super::StopMovementImmediately();
+
+    ClimbFrame.UnrotatedVelocity = FVector::ZeroVector;
+    ClimbFrame.SourceVelocity = FVector::ZeroVector;
+}
+
+//~ End UCharacterMovementComponent Interface
+
+//~ Begin IWorldPartitionStreamingSourceProvider Interface
+
+bool UCustomMovementComponent::GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const
+{
+    // Simulated proxies only follow the server, their climb never waits on local streaming
+    if (!CharacterOwner || !IsInClimbTraversal() || CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy) return false;
+
+    // Input leads velocity, and still points at the next cell while holding at its edge
+    const FVector TravelDirection{(Acceleration.IsNearlyZero() ? Velocity : Acceleration).GetSafeNormal()};
+
+    FWorldPartitionStreamingSource& StreamingSource{OutStreamingSources.AddDefaulted_GetRef()};
+    StreamingSource.Name = ClimbStreamingSourceName;
+    StreamingSource.Location = UpdatedComponent->GetComponentLocation() + TravelDirection * ClimbStreamingLookAhead;
+    StreamingSource.Rotation = TravelDirection.IsZero() ? UpdatedComponent->GetComponentRotation() : TravelDirection.Rotation();
+    StreamingSource.TargetState = EStreamingSourceTargetState::Activated;
+    StreamingSource.Priority = EStreamingSourcePriority::High;
+    StreamingSource.bBlockOnSlowLoading = false;
+
+    FStreamingSourceShape& Shape{StreamingSource.Shapes.AddDefaulted_GetRef()};
+    Shape.bUseGridLoadingRange = false;
+    Shape.Radius = ClimbStreamingSourceRadius;
+
+    return true;
+}
+
+const UObject* UCustomMovementComponent::GetStreamingSourceOwner() const
+{
+    return this;
+}
+
+//~ End IWorldPartitionStreamingSourceProvider Interface
+
+void UCustomMovementComponent::ToggleToClimbing(bool bEnableClimb)
+{
+    if (bEnableClimb)
+    {
+        // Repeated presses only extend the pending request, the retries already cover them
+        if (bClimbIntentPending)
+        {
+            INC_DWORD_STAT(STAT_ClimbRedundantProbesSkipped);
+            ClimbIntentTimeRemaining = ClimbIntentGraceWindow;
+            return;
+        }
+
+        if (TryStartClimbTransition())
+        {
+            SET_FLOAT_STAT(STAT_ClimbIntentLatency, 0.f);
+            return;
+        }
+
+        if (ClimbIntentGraceWindow > 0.f)
+        {
+            bClimbIntentPending = true;
+            ClimbIntentTimeRemaining = ClimbIntentGraceWindow;
+            ClimbIntentRequestTime = FPlatformTime::Seconds();
+        }
+        else
+        {
+            ClearClimbIntent();
+            Debug::Print(TEXT("Cannot Climb Down the Ledge"), FColor::Red, 1);
+        }
+    }
+    else
+    {
+        // Stop climbing
+        //Debug::Print(TEXT("StopClimbing..."), FColor::Green, 3);
+        ClearClimbIntent();
+        StopClimbing();
+    }
+}
+
+bool UCustomMovementComponent::RequestClimbHop()
+{
+    if (!IsClimbing() || IsPlayingClimbTransition()) return false;
+
+    // Hop where the input points, straight up the surface without input
+    FVector HopDirection{FVector::VectorPlaneProject(Acceleration, CurrentClimbableSurface.Normal).GetSafeNormal()};
+    if (HopDirection.IsNearlyZero())
+    {
+        HopDirection = FVector::VectorPlaneProject(UpdatedComponent->GetUpVector(),
+            CurrentClimbableSurface.Normal).GetSafeNormal();
+    }
+
+    Velocity = HopDirection * ClimbHopSpeed;
+    ClimbHopTimeRemaining = ClimbHopDuration;
+    SetMovementMode(MOVE_Custom, ECustomMovementMode::MOVE_ClimbHop);
+
+    return true;
+}
+
+bool UCustomMovementComponent::CanClimbJump() const
+{
+    return IsClimbing() || IsWallRunning() || (IsFalling() && Velocity.Size2D() >= MinWallRunSpeed);
+}
+
+void UCustomMovementComponent::PerformClimbJump()
+{
+    if (!bWantsClimbJump) return;
+    bWantsClimbJump = false;
+
+    if (IsClimbing())
+    {
+        RequestClimbHop();
+    }
+    else if (IsWallRunning())
+    {
+        StopWallRun(true);
+    }
+    else
+    {
+        TryStartWallRun();
+    }
+}
+
+bool UCustomMovementComponent::TryStartLedgeHang()
+{
+    if (IsLedgeHanging()) return true;
+    if (IsPlayingClimbTransition()) return false;
+
+    if (!TraceClimbaleSurface() || !TraceLedgeAbove()) return false;
+
+    ProcessClimbaleSurfaceInfo(0.f);
+    if (CheckShouldStopClimbing()) return false;
+
+    StopMovementImmediately();
+    SetMovementMode(MOVE_Custom, ECustomMovementMode::MOVE_LedgeHang);
+
+    return true;
+}
+
+bool UCustomMovementComponent::TryStartWallRun()
+{
+    if (!IsFalling()) return false;
+    if (Velocity.Size2D() < MinWallRunSpeed) return false;
+
+    // Look for a steep enough wall on the right, then on the left
+    for (const float Side : {1.f, -1.f})
+    {
+        WallRunSide = Side;
+
+        if (TraceClimbaleSurface())
+        {
+            ProcessClimbaleSurfaceInfo(0.f);
+            if (!CheckShouldStopClimbing())
+            {
+                WallRunTimeRemaining = MaxWallRunTime;
+                SetMovementMode(MOVE_Custom, ECustomMovementMode::MOVE_WallRun);
+                return true;
+            }
+        }
+    }
+
+    WallRunSide = 0.f;
+    return false;
+}
+
+void UCustomMovementComponent::StopWallRun(bool bJumpOff)
+{
+    if (!IsWallRunning()) return;
+
+    if (bJumpOff)
+    {
+        Velocity += CurrentClimbableSurface.Normal * WallRunJumpOffSpeed;
+        Velocity.Z = FMath::Max(Velocity.Z, JumpZVelocity * 0.5f);
+    }
+
+    SetMovementMode(MOVE_Falling);
+}
+
+// To check if we are in the state of climbing or not
+bool UCustomMovementComponent::IsClimbing() const
+{
+    return MovementMode == MOVE_Custom && CustomMovementMode ==
+        ECustomMovementMode::MOVE_Climb;
+}
+
+bool UCustomMovementComponent::IsInClimbTraversal() const
+{
+    return MovementMode == MOVE_Custom && CustomMovementMode <
+        ECustomMovementMode::MOVE_MAX;
+}
+
+bool UCustomMovementComponent::IsLedgeHanging() const
+{
+    return MovementMode == MOVE_Custom && CustomMovementMode ==
+        ECustomMovementMode::MOVE_LedgeHang;
+}
+
+bool UCustomMovementComponent::IsWallRunning() const
+{
+    return MovementMode == MOVE_Custom && CustomMovementMode ==
+        ECustomMovementMode::MOVE_WallRun;
+}
+
+
+FClimbStateSnapshot UCustomMovementComponent::CaptureClimbStateSnapshot() const
+{
+    FClimbStateSnapshot Snapshot;
+    if (!IsInClimbTraversal()) return Snapshot;
+
+    Snapshot.CustomMode = CustomMovementMode;
+    Snapshot.SurfaceLocation = CurrentClimbableSurface.Location;
+    Snapshot.SurfaceNormal = CurrentClimbableSurface.Normal;
+    Snapshot.bHasLedgeAbove = CurrentClimbableSurface.bHasLedgeAbove;
+    Snapshot.Anchor = LastClimbUpdateLocation;
+    Snapshot.ModeTimeRemaining = IsWallRunning() ? WallRunTimeRemaining : ClimbHopTimeRemaining;
+    Snapshot.WallRunSide = static_cast<int8>(WallRunSide);
+
+    return Snapshot;
+}
+
+void UCustomMovementComponent::ApplyClimbStateSnapshot(const FClimbStateSnapshot& Snapshot)
+{
+    // Movement mode and root motion are corrected by the character movement component itself
+    if (!Snapshot.IsInClimbTraversal() || !IsInClimbTraversal()) return;
+
+    CurrentClimbableSurface.Location = Snapshot.SurfaceLocation;
+    CurrentClimbableSurface.Normal = Snapshot.SurfaceNormal;
+    CurrentClimbableSurface.bHasLedgeAbove = Snapshot.bHasLedgeAbove;
+    LastClimbUpdateLocation = Snapshot.Anchor;
+
+    if (IsWallRunning())
+    {
+        WallRunTimeRemaining = Snapshot.ModeTimeRemaining;
+        WallRunSide = Snapshot.WallRunSide;
+    }
+    else
+    {
+        ClimbHopTimeRemaining = Snapshot.ModeTimeRemaining;
+    }
+
+    RefreshClimbSurfaceFrame();
+}
+
+TArray<FClimbProbeRecord> UCustomMovementComponent::ConsumeRecordedClimbProbes()
+{
+    return MoveTemp(RecordedClimbProbes);
+}
+
+void UCustomMovementComponent::SetReplayedClimbProbes(TConstArrayView<FClimbProbeRecord> Probes)
+{
+    ReplayedClimbProbes = Probes;
+    NextReplayedClimbProbe = 0;
+}
+
+FClimbSurfaceSample FClimbSurfaceSample::FromHit(const FHitResult& Hit)
+{
+    FClimbSurfaceSample Sample;
+    Sample.ImpactPoint = Hit.ImpactPoint;
+    Sample.ImpactNormal = FVector3f(Hit.ImpactNormal);
+
+    if (const UPrimitiveComponent* HitComponent = Hit.GetComponent())
+    {
+        Sample.ComponentId = HitComponent->GetUniqueID();
+    }
+    Sample.Item = Hit.Item;
+
+    if (const UPhysicalMaterial* PhysicalMaterial = Hit.PhysMaterial.Get())
+    {
+        Sample.MaterialId = PhysicalMaterial->GetUniqueID();
+    }
+
+    return Sample;
+}
+
+bool FClimbSurfacePatch::ProjectPoint(const FVector& Point, FVector& OutLocation, FVector& OutNormal) const
+{
+    if (!IsValid()) return false;
+
+    const FVector SurfaceUp{FVector::VectorPlaneProject(FVector::UpVector, Normal).GetSafeNormal()};
+    if (SurfaceUp.IsZero()) return false;
+
+    const FVector SurfaceRight{FVector::CrossProduct(SurfaceUp, Normal)};
+    const FVector Offset{Point - Location};
+
+    if (FMath::Abs(FVector::DotProduct(Offset, SurfaceRight)) > HalfExtent.X ||
+        FMath::Abs(FVector::DotProduct(Offset, SurfaceUp)) > HalfExtent.Y)
+    {
+        return false;
+    }
+
+    if (!ProjectPointOntoSamples(Samples, Point, OutLocation, OutNormal))
+    {
+        OutLocation = FVector::PointPlaneProject(Point, Location, Normal);
+        OutNormal = Normal;
+    }
+
+    return true;
+}
+
+bool FClimbSurfacePatch::ProjectPointOntoSamples(TConstArrayView<FClimbSurfaceSample> Samples, const FVector& Point,
+    FVector& OutLocation, FVector& OutNormal)
+{
+    const FClimbSurfaceSample* ClosestSample{nullptr};
+    double ClosestDistanceSquared{TNumericLimits<double>::Max()};
+
+    for (const FClimbSurfaceSample& Sample : Samples)
+    {
+        const double DistanceSquared{FVector::DistSquared(Sample.ImpactPoint, Point)};
+        if (DistanceSquared < ClosestDistanceSquared && !Sample.ImpactNormal.IsNearlyZero())
+        {
+            ClosestSample = &Sample;
+            ClosestDistanceSquared = DistanceSquared;
+        }
+    }
+
+    if (!ClosestSample) return false;
+
+    // Corners and ledges show up as several planes, the closest one is the local surface
+    OutNormal = FVector(ClosestSample->ImpactNormal);
+    OutLocation = FVector::PointPlaneProject(Point, ClosestSample->ImpactPoint, OutNormal);
+
+    return true;
+}
+
+SIZE_T UCustomMovementComponent::GetClimbAllocatedSize() const
+{
+    SIZE_T AllocatedSize{ClimbableSurfacesTraceResults.GetAllocatedSize() + ClimbTelemetry.GetAllocatedSize() +
+        RecordedClimbProbes.GetAllocatedSize() + ClimbSurfaceMaterialCache.GetAllocatedSize() +
+        ClimbPhysicalMaterialCache.GetAllocatedSize()};
+
+#if ENABLE_DRAW_DEBUG
+    AllocatedSize += ClimbTelemetryRenderer.GetAllocatedSize();
+#endif
+
+    return AllocatedSize;
+}
+
+void UCustomMovementComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+    Super::GetResourceSizeEx(CumulativeResourceSize);
+
+    CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetClimbAllocatedSize());
+}
+
+#pragma region ClimbTraces
+// Get all objects in fron of character and out it in to an array and return this array.
+TArray<FHitResult> UCustomMovementComponent::DoCapsuleTraceMultiByObject(
+    const FVector& Start, 
+    const FVector& End, 
+    bool bReturnPhysicalMaterial,
+    bool bShowDebugShape,
+    bool bDrawPresistantShapes)
+{
+    INC_DWORD_STAT(STAT_ClimbQueriesIssued);
+    ++NumClimbQueriesIssued;
+
+    // Physical materials are only resolved for surfaces missing from the material cache
+    FCollisionQueryParams QueryParams{SCENE_QUERY_STAT(ClimbSurfaceProbe), false};
+    QueryParams.bReturnPhysicalMaterial = bReturnPhysicalMaterial;
+
+    const FCollisionShape CapsuleShape{FCollisionShape::MakeCapsule(ClimbCapsuleTraceRadius, ClimbCapsuleTraceHalfHeight)};
+
+    TArray<FHitResult> OutCapsuleTraceHitArry;
+    if (bUseClimbableTraceChannel)
+    {
+        // Overlap responses report every climbable surface in the sweep like the object type query does
+        GetWorld()->SweepMultiByChannel(
+            OutCapsuleTraceHitArry,
+            Start,
+            End,
+            FQuat::Identity,
+            ECC_Climbable,
+            CapsuleShape,
+            QueryParams,
+            FCollisionResponseParams(ECR_Overlap)
+        );
+    }
+    else
+    {
+        GetWorld()->SweepMultiByObjectType(
+            OutCapsuleTraceHitArry,
+            Start,
+            End,
+            FQuat::Identity,
+            FCollisionObjectQueryParams(ClimbableSurfaceTraceTypes),
+            CapsuleShape,
+            QueryParams
+        );
+    }
+
+#if ENABLE_DRAW_DEBUG
+    if (bShowDebugShape)
+    {
+        const FColor TraceColor{OutCapsuleTraceHitArry.IsEmpty() ? FColor::Red : FColor::Green};
+
+        DrawDebugCapsule(GetWorld(), End, ClimbCapsuleTraceHalfHeight, ClimbCapsuleTraceRadius, FQuat::Identity,
+            TraceColor, bDrawPresistantShapes);
+
+        for (const FHitResult& Hit : OutCapsuleTraceHitArry)
+        {
+            DrawDebugPoint(GetWorld(), Hit.ImpactPoint, 10.f, FColor::Red, bDrawPresistantShapes);
+        }
+    }
+#endif
+
+    return OutCapsuleTraceHitArry;
+}
+
+FHitResult UCustomMovementComponent::DoLineTraceSingleByObject(
+    const FVector& Start, 
+    const FVector& End, 
+    bool bShowDebugShape,
+    bool bDrawPresistantShapes)
+{
+    FHitResult Out;
+
+    INC_DWORD_STAT(STAT_ClimbQueriesIssued);
+    ++NumClimbQueriesIssued;
+
+    const FCollisionQueryParams QueryParams{SCENE_QUERY_STAT(ClimbLineTrace), false};
+
+    if (bUseClimbableTraceChannel)
+    {
+        GetWorld()->LineTraceSingleByChannel(Out, Start, End, ECC_Climbable, QueryParams);
+    }
+    else
+    {
+        GetWorld()->LineTraceSingleByObjectType(
+            Out,
+            Start,
+            End,
+            FCollisionObjectQueryParams(ClimbableSurfaceTraceTypes),
+            QueryParams
+        );
+    }
+
+#if ENABLE_DRAW_DEBUG
+    if (bShowDebugShape)
+    {
+        if (Out.bBlockingHit)
+        {
+            DrawDebugLine(GetWorld(), Start, Out.ImpactPoint, FColor::Red, bDrawPresistantShapes);
+            DrawDebugLine(GetWorld(), Out.ImpactPoint, End, FColor::Green, bDrawPresistantShapes);
+            DrawDebugPoint(GetWorld(), Out.ImpactPoint, 10.f, FColor::Red, bDrawPresistantShapes);
+        }
+        else
+        {
+            DrawDebugLine(GetWorld(), Start, End, FColor::Red, bDrawPresistantShapes);
+        }
+    }
+#endif
+
+    return Out;
+}
+
+void UCustomMovementComponent::SweepClimbableSurfaces(
+    const FVector& Start,
+    const FVector& End,
+    const FQuat& Rotation,
+    const FCollisionShape& Shape,
+    TArray<FClimbSurfaceSample>& OutSamples) const
+{
+    INC_DWORD_STAT(STAT_ClimbQueriesIssued);
+    ++NumClimbQueriesIssued;
+
+    const FCollisionQueryParams QueryParams{SCENE_QUERY_STAT(ClimbSurfaceSweep), false, CharacterOwner};
+
+    TArray<FHitResult> Hits;
+    if (bUseClimbableTraceChannel)
+    {
+        GetWorld()->SweepMultiByChannel(Hits, Start, End, Rotation, ECC_Climbable, Shape, QueryParams,
+            FCollisionResponseParams(ECR_Overlap));
+    }
+    else
+    {
+        GetWorld()->SweepMultiByObjectType(Hits, Start, End, Rotation,
+            FCollisionObjectQueryParams(ClimbableSurfaceTraceTypes), Shape, QueryParams);
+    }
+
+    OutSamples.Reset(Hits.Num());
+    for (const FHitResult& Hit : Hits)
+    {
+        // Shapes starting inside geometry report a depenetration normal, not the surface
+        if (!Hit.bStartPenetrating && ClimbingSystemCollision::IsClimbableHit(Hit))
+        {
+            OutSamples.Add(FClimbSurfaceSample::FromHit(Hit));
+        }
+    }
+}
+
+#pragma endregion
+
+#pragma region ClimbSurfaceMaterials
+void UCustomMovementComponent::CacheClimbSurfaceMaterial(const FClimbSurfaceSample& Sample,
+    const UPrimitiveComponent* Component, const UPhysicalMaterial* PhysicalMaterial)
+{
+    const uint32 ComponentId{Sample.ComponentId};
+    if (ComponentId == 0) return;
+
+    LLM_SCOPE_BYTAG(ClimbingSystem);
+
+    // Components are not tracked for destruction, flush everything once the cache fills up instead
+    if (ClimbSurfaceMaterialCache.Num() >= ClimbSurfaceMaterialCacheSize && !ClimbSurfaceMaterialCache.Contains(ComponentId))
+    {
+        ClimbSurfaceMaterialCache.Reset();
+        ClimbPhysicalMaterialCache.Reset();
+    }
+
+    FClimbSurfaceMaterialEntry& Entry{ClimbSurfaceMaterialCache.FindOrAdd(ComponentId)};
+    Entry.InstancedComponent = ClimbingSystemCollision::GetClimbDataInstancedComponent(Component);
+    Entry.bMultiMaterial = HasMultipleClimbSurfaceMaterials(Component);
+
+    if (Entry.bMultiMaterial)
+    {
+        bProbingMultiMaterialSurface = true;
+
+        if (Sample.MaterialId != 0 && !ClimbPhysicalMaterialCache.Contains(Sample.MaterialId))
+        {
+            ClimbPhysicalMaterialCache.Add(Sample.MaterialId, UClimbSurfacePhysicalMaterial::GetClimbSurfaceProperties(PhysicalMaterial));
+        }
+    }
+
+    if (Entry.PhysicalMaterial.IsValid() && Entry.PhysicalMaterial == PhysicalMaterial) return;
+
+    Entry.PhysicalMaterial = PhysicalMaterial;
+    Entry.Properties = UClimbSurfacePhysicalMaterial::GetClimbSurfaceProperties(PhysicalMaterial);
+}
+
+bool UCustomMovementComponent::HasMultipleClimbSurfaceMaterials(const UPrimitiveComponent* Component)
+{
+    return Component && (Component->GetNumMaterials() > 1 || Component->IsA<ULandscapeHeightfieldCollisionComponent>());
+}
+
+void UCustomMovementComponent::ResolveClimbSurfaceProperties()
+{
+    FClimbSurfaceProperties Properties;
+    uint32 PreviousComponentId{0};
+    int32 PreviousItem{INDEX_NONE};
+    uint32 PreviousMaterialId{0};
+    bool bHasProperties{false};
+
+    for (const FClimbSurfaceSample& Sample : ClimbableSurfacesTraceResults)
+    {
+        // Hits of the same component, instance and material come in a row and share one lookup
+        if (bHasProperties && Sample.ComponentId == PreviousComponentId && Sample.Item == PreviousItem &&
+            Sample.MaterialId == PreviousMaterialId) continue;
+        PreviousComponentId = Sample.ComponentId;
+        PreviousItem = Sample.Item;
+        PreviousMaterialId = Sample.MaterialId;
+
+        FClimbSurfaceProperties SampleProperties;
+        if (const FClimbSurfaceMaterialEntry* Entry = ClimbSurfaceMaterialCache.Find(Sample.ComponentId))
+        {
+            const FClimbSurfaceProperties* MaterialProperties{Entry->bMultiMaterial ?
+                ClimbPhysicalMaterialCache.Find(Sample.MaterialId) : nullptr};
+
+            SampleProperties = MaterialProperties ? *MaterialProperties : Entry->Properties;
+            INC_DWORD_STAT(STAT_ClimbSurfaceMaterialCacheHits);
+
+            FClimbInstanceData InstanceData;
+            if (ClimbingSystemCollision::GetInstanceClimbData(Entry->InstancedComponent.Get(), Sample.Item, InstanceData))
+            {
+                SampleProperties.SpeedScale *= InstanceData.SpeedScale;
+                SampleProperties.Grip *= InstanceData.Grip;
+            }
+        }
+        else
+        {
+            // Climb on the defaults for now, the next probe asks for the physical material
+            bClimbSurfaceMaterialCacheMiss = true;
+            INC_DWORD_STAT(STAT_ClimbSurfaceMaterialCacheMisses);
+        }
+
+        Properties = bHasProperties ? FClimbSurfaceProperties::Combine(Properties, SampleProperties) : SampleProperties;
+        bHasProperties = true;
+    }
+
+    CurrentClimbSurfaceProperties = Properties;
+}
+
+void UCustomMovementComponent::InvalidateClimbSurfaceMaterialCache()
+{
+    ClimbSurfaceMaterialCache.Reset();
+    ClimbPhysicalMaterialCache.Reset();
+    bClimbSurfaceMaterialCacheMiss = true;
+}
+#pragma endregion
+
+#pragma region ClimbCore
+// Core method for tracing surfaces,return true if near a climbable surface
+bool UCustomMovementComponent::TraceClimbaleSurface()
+{
+    const FVector ProbeDirection{GetClimbProbeDirection()};
+
+    // Offset start position to prevent self-collision
+    const FVector StartOffset{ProbeDirection * 30.f};
+    const FVector Start{UpdatedComponent->GetComponentLocation() + StartOffset};
+    const FVector End{Start + ProbeDirection};
+
+    LLM_SCOPE_BYTAG(ClimbingSystem);
+
+    // Create capsule to detect climble suefaces in front, keeping only what the solver needs
+    const bool bResolveMaterials{bClimbSurfaceMaterialCacheMiss || bProbingMultiMaterialSurface};
+    const TArray<FHitResult> ClimbableSurfaceHits{DoCapsuleTraceMultiByObject(Start, End, bResolveMaterials, false)};
+
+    if (bResolveMaterials)
+    {
+        bProbingMultiMaterialSurface = false;
+    }
+
+    ClimbableSurfacesTraceResults.Reset(ClimbableSurfaceHits.Num());
+    for (const FHitResult& ClimbableSurfaceHit : ClimbableSurfaceHits)
+    {
+        // Instanced meshes flag their unclimbable instances, one custom data read per hit
+        if (!ClimbingSystemCollision::IsClimbableHit(ClimbableSurfaceHit)) continue;
+
+        ClimbableSurfacesTraceResults.Add(FClimbSurfaceSample::FromHit(ClimbableSurfaceHit));
+
+        if (bResolveMaterials)
+        {
+            CacheClimbSurfaceMaterial(ClimbableSurfacesTraceResults.Last(), ClimbableSurfaceHit.GetComponent(),
+                ClimbableSurfaceHit.PhysMaterial.Get());
+        }
+    }
+
+    if (bResolveMaterials)
+    {
+        bClimbSurfaceMaterialCacheMiss = false;
+    }
+
+    return !ClimbableSurfacesTraceResults.IsEmpty();
+}
+
+FVector UCustomMovementComponent::GetClimbProbeDirection() const
+{
+    if (WallRunSide != 0.f)
+    {
+        return UpdatedComponent->GetRightVector() * WallRunSide;
+    }
+
+    return UpdatedComponent->GetForwardVector();
+}
+
+bool UCustomMovementComponent::TraceLedgeAbove()
+{
+    FHitResult LedgeHitResult = 
+        TraceFromEyeHeight(100.f, 50.f);
+
+    if (LedgeHitResult.bBlockingHit) return false;
+
+    const FVector WalkableSurfaceTraceStart{LedgeHitResult.TraceEnd};
+
+    const FVector DownVector{-UpdatedComponent->GetUpVector()};
+    const FVector WalkableSurfaceTraceEnd{WalkableSurfaceTraceStart + DownVector * 100.f};
+    FHitResult WalkableSurfaceHitResult =
+        DoLineTraceSingleByObject(WalkableSurfaceTraceStart, WalkableSurfaceTraceEnd, true);
+
+    return WalkableSurfaceHitResult.bBlockingHit;
+}
+
+FHitResult UCustomMovementComponent::TraceFromEyeHeight(
+    float TraceDistance,
+    float TraceStartOffset)
+{
+    // Calculate start position at character eye
+    const FVector HeightOffset{UpdatedComponent->GetUpVector() *
+        (TraceStartOffset + CharacterOwner->BaseEyeHeight)};
+
+    const FVector Start{UpdatedComponent->GetComponentLocation() +
+        HeightOffset};
+    const FVector End{Start + UpdatedComponent->GetForwardVector() *
+        TraceDistance};
+
+    // Create line trace to detect surface
+    return DoLineTraceSingleByObject(Start, End, true);
+}
+
+// To check if player can climb, return true if yes
+bool UCustomMovementComponent::CanStartClimbing()
+{
+    // Must be on ground and facing climbale surface
+    if (IsFalling()) return false;
+    if (!TraceClimbaleSurface()) return false;
+
+    //Must have overhead clearance
+    if (!TraceFromEyeHeight(90.f).bBlockingHit) return false;
+
+    return true;
+}
+
+bool UCustomMovementComponent::CanClimbDownLedge()
+{
+    if (IsFalling()) return false;
+
+    const FVector ComponentLocation{UpdatedComponent->GetComponentLocation()};
+    const FVector ComponentForwardVector{UpdatedComponent->GetForwardVector()};
+    const FVector DownVector{-UpdatedComponent->GetUpVector()};
+
+    const FVector WalkableSurfaceTraceStart{ComponentLocation + ComponentForwardVector * ClimbDownSurfaceTraceOffset};
+    const FVector WalkableSurfaceTraceEnd{WalkableSurfaceTraceStart + DownVector * 100.f};
+
+    FHitResult WalkableSurfaseHit{DoLineTraceSingleByObject(WalkableSurfaceTraceStart, WalkableSurfaceTraceEnd, true)};
+
+    const FVector LedgeTraceStart{WalkableSurfaseHit.TraceStart + ComponentForwardVector * ClimbDownLedgeSurfaceTraceOffset};
+    const FVector LedgeTraceEnd{LedgeTraceStart + DownVector * 200.f};
+
+    FHitResult LedgeTraceHit = DoLineTraceSingleByObject(LedgeTraceStart, LedgeTraceEnd, true);
+
+    if (WalkableSurfaseHit.bBlockingHit && !LedgeTraceHit.bBlockingHit) return true;
+
+    return false;
+}
+
+void UCustomMovementComponent::StartClimbing()
+{
+    SetMovementMode(MOVE_Custom,ECustomMovementMode::MOVE_Climb);
+}
+
+void UCustomMovementComponent::StopClimbing()
+{
+    SetMovementMode(MOVE_Falling);
+}
+
+void UCustomMovementComponent::PhysClimb(float deltaTime, int32 Iterations)
+{
+    if (deltaTime < MIN_TICK_TIME)
+    {
+        return;
+    }
+
+    /** Process all the climbable surfaces info */
+    if (UpdateClimbSurfaceInfo(deltaTime) && CheckHasReachedFloor())
+    {
+        PendingClimbTelemetry.Flags |= EClimbTelemetryFlags::ReachedFloor;
+    }
+
+    // Check if we should stop climbing
+    if (CheckShouldStopClimbing())
+    {
+        StopClimbing();
+    }
+
+    if (bHoldingForClimbStreaming)
+    {
+        INC_DWORD_STAT(STAT_ClimbStreamingHolds);
+        Velocity = FVector::ZeroVector;
+        return;
+    }
+
+    RestorePreAdditiveRootMotionVelocity();
+
+    if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+    {
+    // Define the max speed and acceleration
+        CalcVelocity(deltaTime, 0.f, true, MaxBreakClimbDeceleration * CurrentClimbSurfaceProperties.Grip);
+    }
+
+    ApplyRootMotionToVelocity(deltaTime);
+
+    MoveAlongClimbSurface(deltaTime, Iterations);
+
+    if (CheckHasReachedLedge())
+    {
+        PendingClimbTelemetry.Flags |= EClimbTelemetryFlags::ReachedLedge;
+        if (bAutoHangAtLedge)
+        {
+            StopMovementImmediately();
+            SetMovementMode(MOVE_Custom, ECustomMovementMode::MOVE_LedgeHang);
+        }
+        else
+        {
+            PlayClimbMontage(ClimbToTopMontage);
+        }
+    }
+}
+
+void UCustomMovementComponent::PhysLedgeHang(float deltaTime, int32 Iterations)
+{
+    if (deltaTime < MIN_TICK_TIME)
+    {
+        return;
+    }
+
+    UpdateClimbSurfaceInfo(deltaTime);
+
+    if (CheckShouldStopClimbing())
+    {
+        StopClimbing();
+        StartNewPhysics(deltaTime, Iterations);
+        return;
+    }
+
+    if (bHoldingForClimbStreaming)
+    {
+        INC_DWORD_STAT(STAT_ClimbStreamingHolds);
+        Velocity = FVector::ZeroVector;
+        return;
+    }
+
+    if (!IsPlayingClimbTransition())
+    {
+        // Ledge ran out under the hands, fall back to climbing the wall below it
+        const FVector InputDirection{ClimbFrame.Rotation.UnrotateVector(
+            Acceleration.GetSafeNormal())};
+
+        if (!CurrentClimbableSurface.bHasLedgeAbove || InputDirection.Z < -0.7f)
+        {
+            StartClimbing();
+            StartNewPhysics(deltaTime, Iterations);
+            return;
+        }
+
+        if (InputDirection.Z > 0.7f)
+        {
+            PlayClimbMontage(ClimbToTopMontage);
+        }
+    }
+
+    // Shimmy only along the ledge
+    const FVector LedgeDirection{FVector::CrossProduct(
+        CurrentClimbableSurface.Normal, FVector::UpVector).GetSafeNormal()};
+
+    RestorePreAdditiveRootMotionVelocity();
+
+    if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+    {
+        Acceleration = Acceleration.ProjectOnTo(LedgeDirection);
+        CalcVelocity(deltaTime, 0.f, true, MaxBreakClimbDeceleration * CurrentClimbSurfaceProperties.Grip);
+        Velocity = Velocity.ProjectOnTo(LedgeDirection);
+    }
+
+    ApplyRootMotionToVelocity(deltaTime);
+
+    MoveAlongClimbSurface(deltaTime, Iterations);
+}
+
+void UCustomMovementComponent::PhysClimbHop(float deltaTime, int32 Iterations)
+{
+    if (deltaTime < MIN_TICK_TIME)
+    {
+        return;
+    }
+
+    UpdateClimbSurfaceInfo(deltaTime);
+
+    if (CheckShouldStopClimbing())
+    {
+        StopClimbing();
+        StartNewPhysics(deltaTime, Iterations);
+        return;
+    }
+
+    // Hops are unpowered, only keep them in the plane of the surface as it curves
+    Velocity = FVector::VectorPlaneProject(Velocity, CurrentClimbableSurface.Normal);
+
+    MoveAlongClimbSurface(deltaTime, Iterations);
+
+    ClimbHopTimeRemaining -= deltaTime;
+    if (ClimbHopTimeRemaining <= 0.f)
+    {
+        StartClimbing();
+    }
+}
+
+void UCustomMovementComponent::PhysWallRun(float deltaTime, int32 Iterations)
+{
+    if (deltaTime < MIN_TICK_TIME)
+    {
+        return;
+    }
+
+    UpdateClimbSurfaceInfo(deltaTime);
+
+    WallRunTimeRemaining -= deltaTime;
+
+    // Run along the wall under reduced gravity
+    FVector RunVelocity{FVector::VectorPlaneProject(Velocity, CurrentClimbableSurface.Normal)};
+    RunVelocity.Z += GetGravityZ() * WallRunGravityScale * deltaTime;
+
+    if (CheckShouldStopClimbing() || WallRunTimeRemaining <= 0.f ||
+        RunVelocity.Size2D() < MinWallRunSpeed)
+    {
+        StopWallRun(false);
+        StartNewPhysics(deltaTime, Iterations);
+        return;
+    }
+
+    Velocity = RunVelocity.GetClampedToMaxSize(MaxWallRunSpeed);
+
+    MoveAlongClimbSurface(deltaTime, Iterations);
+}
+
+bool UCustomMovementComponent::UpdateClimbSurfaceInfo(float DeltaTime)
+{
+    const FVector ClimbUpdateLocation{UpdatedComponent->GetComponentLocation()};
+    const FClimbProbeRecord* ReplayedProbe{ConsumeReplayedClimbProbe()};
+
+    /** Probe only when the frame budget allows, otherwise carry the cached surface along */
+    const bool bCanProbe{ReplayedProbe ? ReplayedProbe->bProbed :
+        ClimbableSurfacesTraceResults.IsEmpty() || ConsumeClimbQueryBudget()};
+
+    if (bCanProbe)
+    {
+        if (ReplayedProbe)
+        {
+            // Carry the recorded hits over the small offset of the replay, like the cached surface
+            const FVector ReplayOffset{ClimbUpdateLocation - ReplayedProbe->Location};
+
+            ClimbableSurfacesTraceResults = ReplayedProbe->Samples;
+            for (FClimbSurfaceSample& Sample : ClimbableSurfacesTraceResults)
+            {
+                Sample.ImpactPoint += FVector::VectorPlaneProject(ReplayOffset, FVector(Sample.ImpactNormal));
+            }
+
+            PendingClimbTelemetry.Flags |= EClimbTelemetryFlags::ReplayedProbe;
+            INC_DWORD_STAT(STAT_ClimbReplayProbesReused);
+        }
+        else
+        {
+            TraceClimbaleSurface();
+        }
+
+        PendingClimbTelemetry.Flags |= EClimbTelemetryFlags::Probed;
+        PendingClimbTelemetry.NumProbeHits = static_cast<uint16>(ClimbableSurfacesTraceResults.Num());
+
+        // Keep the last surface until the cell ahead has streamed in
+        if (ShouldHoldForClimbStreaming(DeltaTime))
+        {
+            PendingClimbTelemetry.Flags |= EClimbTelemetryFlags::StreamingHold;
+        }
+        else
+        {
+            ProcessClimbaleSurfaceInfo(DeltaTime);
+
+            // Wall runs never grab ledges, save the traces
+            CurrentClimbableSurface.bHasLedgeAbove = ReplayedProbe ? ReplayedProbe->bHasLedgeAbove :
+                !IsWallRunning() && TraceLedgeAbove();
+        }
+    }
+    else
+    {
+        CurrentClimbableSurface.Location += FVector::VectorPlaneProject(
+            ClimbUpdateLocation - LastClimbUpdateLocation, CurrentClimbableSurface.Normal);
+    }
+    LastClimbUpdateLocation = ClimbUpdateLocation;
+
+    // Autonomous proxies keep every update with its saved move for later replays
+    if (CharacterOwner->GetLocalRole() == ROLE_AutonomousProxy && !CharacterOwner->bClientUpdating)
+    {
+        LLM_SCOPE_BYTAG(ClimbingSystem);
+
+        FClimbProbeRecord& Record{RecordedClimbProbes.AddDefaulted_GetRef()};
+        Record.Location = ClimbUpdateLocation;
+        Record.ProbeDirection = FVector3f(GetClimbProbeDirection());
+        Record.SurfaceComponentId = ClimbableSurfacesTraceResults.IsEmpty() ? 0 : ClimbableSurfacesTraceResults[0].ComponentId;
+        Record.bProbed = bCanProbe;
+        Record.bHasLedgeAbove = CurrentClimbableSurface.bHasLedgeAbove;
+
+        if (bCanProbe)
+        {
+            Record.Samples = ClimbableSurfacesTraceResults;
+        }
+    }
+
+    // Reused probes skip the follow-up floor trace as well
+    return bCanProbe && !ReplayedProbe;
+}
+
+const FClimbProbeRecord* UCustomMovementComponent::ConsumeReplayedClimbProbe()
+{
+    if (!CharacterOwner->bClientUpdating || !ReplayedClimbProbes.IsValidIndex(NextReplayedClimbProbe)) return nullptr;
+
+    const FClimbProbeRecord& Record{ReplayedClimbProbes[NextReplayedClimbProbe++]};
+
+    // The correction moved the replay off the recorded path, the recorded hits no longer apply
+    if (FVector::DistSquared(UpdatedComponent->GetComponentLocation(), Record.Location) >
+        FMath::Square(ClimbReplayProbeTolerance)) return nullptr;
+
+    if (FVector::DotProduct(GetClimbProbeDirection(), FVector(Record.ProbeDirection)) < 0.999f) return nullptr;
+
+    // Same for a replay that is on another surface than the recorded one
+    const bool bOnRecordedSurface{ClimbableSurfacesTraceResults.ContainsByPredicate(
+        [&Record](const FClimbSurfaceSample& Sample)
+        {
+            return Sample.ComponentId == Record.SurfaceComponentId;
+        })};
+
+    return bOnRecordedSurface ? &Record : nullptr;
+}
+
+void UCustomMovementComponent::MoveAlongClimbSurface(float deltaTime, int32 Iterations)
+{
+    if (!CVarClimbAdaptiveSubsteps.GetValueOnGameThread())
+    {
+        FVector OldLocation = UpdatedComponent->GetComponentLocation();
+        const FVector Adjusted = Velocity * deltaTime;
+        FHitResult Hit(1.f);
+
+        /** Handle climb rotation */
+        SafeMoveUpdatedComponent(Adjusted, GetClimbRotation(deltaTime), true, Hit);
+        INC_DWORD_STAT(STAT_ClimbMoveSweeps);
+
+        if (Hit.Time < 1.f)
+        {
+            INC_DWORD_STAT(STAT_ClimbSlideIterations);
+            INC_DWORD_STAT(STAT_ClimbMoveSweeps);
+
+            //adjust and try again
+            HandleImpact(Hit, deltaTime, Adjusted);
+            SlideAlongSurface(Adjusted, (1.f - Hit.Time), Hit.Normal, Hit, true);
+        }
+
+        if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+        {
+            Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / deltaTime;
+        }
+
+        /** Snap to climbable surface */
+        SnapMovementToClimbableSurfaces(deltaTime);
+
+        RefreshClimbFrame();
+        return;
+    }
+
+    const FVector OldLocation{UpdatedComponent->GetComponentLocation()};
+    const int32 NumSteps{GetNumClimbSubsteps(deltaTime, Iterations)};
+    const float StepTime{deltaTime / NumSteps};
+
+    for (int32 Step = 0; Step < NumSteps; ++Step)
+    {
+        // Snap from where this step starts, so it follows the surface as the climber moves over it
+        const FVector SnapVector{ClimbSurfaceMath::GetSnapVector(CurrentClimbableSurface,
+            UpdatedComponent->GetComponentLocation(), GetClimbProbeDirection())};
+
+        if (Step == 0)
+        {
+            PendingClimbTelemetry.SnapVector = FVector3f(SnapVector);
+        }
+
+        const FVector StepDelta{(Velocity + SnapVector * MaxClimbSpeed) * StepTime};
+        const FQuat StepRotation{GetClimbRotation(StepTime)};
+
+        if (StepDelta.IsNearlyZero() && StepRotation.Equals(UpdatedComponent->GetComponentQuat())) continue;
+
+        FHitResult Hit(1.f);
+        SafeMoveUpdatedComponent(StepDelta, StepRotation, true, Hit);
+        INC_DWORD_STAT(STAT_ClimbMoveSweeps);
+
+        if (Hit.Time < 1.f)
+        {
+            INC_DWORD_STAT(STAT_ClimbSlideIterations);
+            INC_DWORD_STAT(STAT_ClimbMoveSweeps);
+
+            HandleImpact(Hit, StepTime, StepDelta);
+            SlideAlongSurface(StepDelta, (1.f - Hit.Time), Hit.Normal, Hit, true);
+        }
+    }
+
+    // The snap runs along the surface normal, leave it out of the velocity like a separate correction would be
+    if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+    {
+        const FVector Moved{UpdatedComponent->GetComponentLocation() - OldLocation};
+
+        Velocity = (CurrentClimbableSurface.Normal.IsZero() ? Moved :
+            FVector::VectorPlaneProject(Moved, CurrentClimbableSurface.Normal)) / deltaTime;
+    }
+
+    RefreshClimbFrame();
+}
+
+int32 UCustomMovementComponent::GetNumClimbSubsteps(float deltaTime, int32 Iterations) const
+{
+    const float MoveDistance{static_cast<float>(Velocity.Size()) * deltaTime};
+
+    // No step may move further than MaxClimbSubstepDistance, turn with the surface more than
+    // MaxClimbSubstepAngle or last longer than MaxSimulationTimeStep
+    const float DistanceSteps{MoveDistance / FMath::Max(MaxClimbSubstepDistance, 1.f)};
+    const float CurvatureSteps{MoveDistance * ClimbSurfaceCurvature /
+        FMath::DegreesToRadians(FMath::Max(MaxClimbSubstepAngle, 1.f))};
+    const float TimeSteps{deltaTime / FMath::Max(MaxSimulationTimeStep, MIN_TICK_TIME)};
+
+    const int32 NumSteps{FMath::CeilToInt32(FMath::Max3(DistanceSteps, CurvatureSteps, TimeSteps))};
+
+    return FMath::Clamp(NumSteps, 1, FMath::Max(MaxSimulationIterations - Iterations, 1));
+}
+
+bool UCustomMovementComponent::ConsumeClimbQueryBudget() const
+{
+    // Replayed moves and unregistered climbers are not throttled
+    if (!ClimbQueryBudget || CharacterOwner->bClientUpdating) return true;
+
+    if (IsExemptFromClimbQueryBudget()) return true;
+
+    return ClimbQueryBudget->TryConsumeQueries(this, ClimbProbeQueryCost);
+}
+
+bool UCustomMovementComponent::IsExemptFromClimbQueryBudget() const
+{
+    if (!CharacterOwner) return false;
+
+    // The roles cover the window before the controller has replicated
+    return CharacterOwner->IsPlayerControlled() ||
+        CharacterOwner->GetLocalRole() == ROLE_AutonomousProxy ||
+        CharacterOwner->GetRemoteRole() == ROLE_AutonomousProxy;
+}
+
+void UCustomMovementComponent::ProcessClimbaleSurfaceInfo(float DeltaTime)
+{
+    const FVector PreviousNormal{CurrentClimbableSurface.Normal};
+
+    const FClimbSurfaceInfo Estimate{ClimbSurfaceMath::EstimateSurface(ClimbableSurfacesTraceResults,
+        UpdatedComponent->GetComponentLocation(), ClimbSurfaceOutlierAngle)};
+
+    CurrentClimbableSurface.Location = Estimate.Location;
+    CurrentClimbableSurface.Normal = ClimbSurfaceMath::SmoothNormal(PreviousNormal, Estimate.Normal,
+        DeltaTime, ClimbSurfaceNormalSmoothingTime);
+
+    RefreshClimbSurfaceFrame();
+
+    ResolveClimbSurfaceProperties();
+
+    // Spread of the hit normals over the probed height, radians per centimeter
+    float MinNormalDot{1.f};
+    for (const FClimbSurfaceSample& Sample : ClimbableSurfacesTraceResults)
+    {
+        MinNormalDot = FMath::Min(MinNormalDot, static_cast<float>(FVector::DotProduct(FVector(Sample.ImpactNormal), Estimate.Normal)));
+    }
+
+    ClimbSurfaceCurvature = FMath::Acos(FMath::Clamp(MinNormalDot, -1.f, 1.f)) / FMath::Max(ClimbCapsuleTraceHalfHeight * 2.f, 1.f);
+}
+
+void UCustomMovementComponent::PublishClimbSurfacePatch()
+{
+    if (!IsInClimbTraversal() || CurrentClimbableSurface.Normal.IsZero())
+    {
+        if (ClimbSurfacePatch.IsValid())
+        {
+            ClimbSurfacePatch.Normal = FVector::ZeroVector;
+            ClimbSurfacePatch.Samples.Reset();
+        }
+        return;
+    }
+
+    // The probe capsule is swept along the surface normal, so its size is the probed area
+    ClimbSurfacePatch.Location = CurrentClimbableSurface.Location;
+    ClimbSurfacePatch.Normal = CurrentClimbableSurface.Normal;
+    ClimbSurfacePatch.HalfExtent = FVector2f(ClimbCapsuleTraceRadius, ClimbCapsuleTraceHalfHeight);
+
+    ClimbSurfacePatch.Samples.Reset();
+    ClimbSurfacePatch.Samples.Append(ClimbableSurfacesTraceResults);
+}
+
+void UCustomMovementComponent::UpdateSimulatedClimbSurface(float DeltaTime)
+{
+    if (CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy || !IsInClimbTraversal()) return;
+
+    // WallRunSide is not replicated, the probe would look ahead instead of at the wall, and the
+    // wall run has no limb IK to feed anyway
+    if (IsWallRunning()) return;
+
+    SimulatedClimbProbeTimer -= DeltaTime;
+
+    // Only animation reads the result, nobody sees the limbs of an off screen proxy
+    if (SimulatedClimbProbeTimer > 0.f || !CharacterOwner->GetMesh()->WasRecentlyRendered()) return;
+
+    const float ProbeDeltaTime{SimulatedClimbProbeInterval - SimulatedClimbProbeTimer};
+    SimulatedClimbProbeTimer = SimulatedClimbProbeInterval;
+
+    if (TraceClimbaleSurface())
+    {
+        ProcessClimbaleSurfaceInfo(ProbeDeltaTime);
+    }
+}
+
+bool UCustomMovementComponent::CheckShouldStopClimbing()
+{
+    if (ClimbableSurfacesTraceResults.IsEmpty()) return !bClimbSurfaceStreaming;
+
+    // Compare cosines against the precomputed cutoff instead of converting to degrees
+    PendingClimbTelemetry.SurfaceUpDot = ClimbFrame.SurfaceUpDot;
+
+    if (ClimbFrame.SurfaceUpDot >= CurrentClimbSurfaceProperties.StopAngleCos)
+    {
+        PendingClimbTelemetry.Flags |= EClimbTelemetryFlags::ShouldStop;
+        return true;
+    }
+
+    return false;
+}
+
+bool UCustomMovementComponent::CheckHasReachedFloor()
+{
+    const FVector UnrotatedClimbVelocity{GetUnrotatedClimbVelocity()};
+
+    // If Character is Climbing Up,means he is not going to reach floor.
+    if (UnrotatedClimbVelocity.Z > 10.f) return false;
+
+    const FVector DownVector{-UpdatedComponent->GetUpVector()};
+    const FVector StartOffset{DownVector * 50.f};
+
+    const FVector Start{UpdatedComponent->GetComponentLocation() + StartOffset};
+    const FVector End{Start + DownVector};
+
+    TArray<FHitResult> PossibleFloorHits{
+        DoCapsuleTraceMultiByObject(Start, End, true)};
+
+    if (PossibleFloorHits.IsEmpty()) return false;
+
+    for (const FHitResult& PossibleFloorHit : PossibleFloorHits)
+    {
+        const bool bFloorReached = FVector::Parallel(
+            -PossibleFloorHit.ImpactNormal, FVector::UpVector) &&
+            UnrotatedClimbVelocity.Z < -10.f;
+
+        if (bFloorReached)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool UCustomMovementComponent::CheckHasReachedLedge()
+{
+    // Ledge traces run with the shared surface probe
+    return CurrentClimbableSurface.bHasLedgeAbove && GetUnrotatedClimbVelocity().Z > 10.f;
+}
+
+FQuat UCustomMovementComponent::GetClimbRotation(float DeltaTime)
+{
+    const FQuat CurrentQuat{UpdatedComponent->GetComponentQuat()};
+    
+    if (HasAnimRootMotion() || CurrentRootMotion.HasOverrideVelocity())
+    {
+        return CurrentQuat;
+    }
+
+    FQuat TargetQuat{ClimbFrame.SurfaceRotation};
+
+    // Wall runs face along the wall instead of into it
+    if (IsWallRunning())
+    {
+        const FVector RunDirection{FVector::VectorPlaneProject(Velocity,
+            CurrentClimbableSurface.Normal).GetSafeNormal2D()};
+
+        TargetQuat = RunDirection.IsNearlyZero() ? CurrentQuat :
+            FRotationMatrix::MakeFromX(RunDirection).ToQuat();
+    }
+
+    return FMath::QInterpTo(CurrentQuat, TargetQuat, DeltaTime, 5.f);
+}
+
+void UCustomMovementComponent::SnapMovementToClimbableSurfaces(float DeltaTime)
+{
+    const FVector SnapVector{ClimbSurfaceMath::GetSnapVector(CurrentClimbableSurface,
+        UpdatedComponent->GetComponentLocation(), GetClimbProbeDirection())};
+
+    PendingClimbTelemetry.SnapVector = FVector3f(SnapVector);
+
+    UpdatedComponent->MoveComponent(
+        SnapVector * DeltaTime * MaxClimbSpeed,
+        UpdatedComponent->GetComponentQuat(),
+        true);
+    INC_DWORD_STAT(STAT_ClimbMoveSweeps);
+}
+
+bool UCustomMovementComponent::PlayClimbMontage(const TSoftObjectPtr<UAnimMontage>& MontageToPlay)
+{
+    if (MontageToPlay.IsNull()) return false;
+    if (BakedClimbRootMotionId != 0) return false;
+
+    if (ShouldUseBakedClimbRootMotion() && PlayBakedClimbRootMotion(MontageToPlay))
+    {
+        // Still show the montage where it renders, its root motion is already in the baked source
+        if (OwningPlayerAnimInstance && !IsNetMode(NM_DedicatedServer))
+        {
+            UAnimMontage* Montage{ResolveClimbMontage(MontageToPlay)};
+            if (Montage && OwningPlayerAnimInstance->Montage_Play(Montage) > 0.f)
+            {
+                if (FAnimMontageInstance* MontageInstance = OwningPlayerAnimInstance->GetActiveInstanceForMontage(Montage))
+                {
+                    MontageInstance->PushDisableRootMotion();
+                }
+            }
+        }
+        return true;
+    }
+
+    if (!OwningPlayerAnimInstance) return false;
+    if (OwningPlayerAnimInstance->IsAnyMontagePlaying()) return false;
+
+    UAnimMontage* Montage{ResolveClimbMontage(MontageToPlay)};
+
+    return Montage && OwningPlayerAnimInstance->Montage_Play(Montage) > 0.f;
+}
+
+void UCustomMovementComponent::OnClimbMontageEnded(UAnimMontage* Montage, bool bInterrupted)
+{
+    Debug::Print(TEXT("Climb Montage Ended..."));
+    if (!Montage) return;
+
+    // Baked transitions finish with their root motion source, the montage only showed them
+    if (ShouldUseBakedClimbRootMotion() && ClimbRootMotionTable->FindTrack(TSoftObjectPtr<UAnimMontage>(Montage))) return;
+
+    OnClimbTransitionFinished(FSoftObjectPath(Montage));
+}
+
+void UCustomMovementComponent::OnClimbTransitionFinished(const FSoftObjectPath& MontagePath)
+{
+    if (MontagePath == IdleToClimbMontage.ToSoftObjectPath() || MontagePath == ClimbDownLedgeMontage.ToSoftObjectPath())
+    {
+        StartClimbing();
+        StopMovementImmediately();
+    }
+    if (MontagePath == ClimbToTopMontage.ToSoftObjectPath())
+    {
+        SetMovementMode(MOVE_Walking);
+    }
+}
+
+bool UCustomMovementComponent::IsPlayingClimbTransition() const
+{
+    return HasAnimRootMotion() || BakedClimbRootMotionId != 0;
+}
+
+FVector UCustomMovementComponent::GetUnrotatedClimbVelocity() const
+{
+    if (IsInClimbTraversal() && ClimbFrame.SourceVelocity == Velocity)
+    {
+        return ClimbFrame.UnrotatedVelocity;
+    }
+
+    return UpdatedComponent->GetComponentQuat().UnrotateVector(Velocity);
+}
+
+void UCustomMovementComponent::RefreshClimbFrame()
+{
+    ClimbFrame.Rotation = UpdatedComponent->GetComponentQuat();
+    ClimbFrame.UnrotatedVelocity = ClimbFrame.Rotation.UnrotateVector(Velocity);
+    ClimbFrame.SourceVelocity = Velocity;
+}
+
+void UCustomMovementComponent::RefreshClimbSurfaceFrame()
+{
+    const FVector& SurfaceNormal{CurrentClimbableSurface.Normal};
+
+    ClimbFrame.SurfaceRotation = ClimbSurfaceMath::GetSurfaceRotation(SurfaceNormal, ClimbFrame.Rotation);
+    ClimbFrame.SurfaceUpDot = SurfaceNormal.Z;
+}
+#pragma endregion
+
+#pragma region ClimbBakedRootMotion
+bool UCustomMovementComponent::ShouldUseBakedClimbRootMotion() const
+{
+    if (!ClimbRootMotionTable) return false;
+
+    switch (CVarClimbBakedRootMotion.GetValueOnGameThread())
+    {
+    case 1:
+        // Server and owning client must move the same way, or every transition gets corrected
+        return !IsNetMode(NM_Standalone);
+    case 2:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool UCustomMovementComponent::PlayBakedClimbRootMotion(const TSoftObjectPtr<UAnimMontage>& Montage)
+{
+    const int32 TrackIndex{ClimbRootMotionTable->FindTrackIndex(Montage)};
+    const FClimbRootMotionTrack* Track{ClimbRootMotionTable->GetTrack(TrackIndex)};
+    if (!Track) return false;
+
+    TSharedPtr<FRootMotionSource_ClimbTrack> RootMotionSource{MakeShared<FRootMotionSource_ClimbTrack>()};
+    RootMotionSource->Table = ClimbRootMotionTable;
+    RootMotionSource->TrackIndex = TrackIndex;
+    RootMotionSource->Duration = Track->PlayLength;
+    RootMotionSource->MeshTransform = CharacterOwner->GetMesh()->GetComponentTransform();
+
+    BakedClimbRootMotionId = ApplyRootMotionSource(RootMotionSource);
+    BakedClimbMontagePath = Montage.ToSoftObjectPath();
+
+    return BakedClimbRootMotionId != 0;
+}
+
+void UCustomMovementComponent::UpdateBakedClimbRootMotion()
+{
+    if (BakedClimbRootMotionId == 0 || GetRootMotionSourceByID(BakedClimbRootMotionId).IsValid()) return;
+
+    // Clear first, finishing the transition may start the next one
+    const FSoftObjectPath FinishedMontagePath{BakedClimbMontagePath};
+    BakedClimbRootMotionId = 0;
+    BakedClimbMontagePath.Reset();
+
+    OnClimbTransitionFinished(FinishedMontagePath);
+}
+#pragma endregion
+
+#pragma region ClimbIntent
+bool UCustomMovementComponent::TryStartClimbTransition()
+{
+    // Rejections that need no queries first
+    if (IsPlayingClimbTransition() || IsFalling()) return false;
+    if (OwningPlayerAnimInstance && OwningPlayerAnimInstance->IsAnyMontagePlaying()) return false;
+
+    const FVector ComponentLocation{UpdatedComponent->GetComponentLocation()};
+    const FVector ComponentForward{UpdatedComponent->GetForwardVector()};
+
+    // Same pose as the last probe that failed, it would fail again
+    if (bHasFailedClimbStartProbe &&
+        FVector::DistSquared(ComponentLocation, FailedClimbStartProbeLocation) < FMath::Square(1.f) &&
+        FVector::DotProduct(ComponentForward, FailedClimbStartProbeForward) > 0.999f)
+    {
+        INC_DWORD_STAT(STAT_ClimbRedundantProbesSkipped);
+        return false;
+    }
+
+    if (CanStartClimbing())
+    {
+        // Enter the climb state
+        //Debug::Print(TEXT("Start Climbing..."), FColor::Green, 3);
+        return PlayClimbMontage(IdleToClimbMontage);
+    }
+
+    if (CanClimbDownLedge() && PlayClimbMontage(ClimbDownLedgeMontage))
+    {
+        CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(40.f);
+        return true;
+    }
+
+    bHasFailedClimbStartProbe = true;
+    FailedClimbStartProbeLocation = ComponentLocation;
+    FailedClimbStartProbeForward = ComponentForward;
+
+    return false;
+}
+
+void UCustomMovementComponent::UpdateClimbIntent(float DeltaTime)
+{
+    if (!bClimbIntentPending) return;
+
+    // Started by something else meanwhile, like an auto ledge grab
+    if (IsInClimbTraversal() || TryStartClimbTransition())
+    {
+        SET_FLOAT_STAT(STAT_ClimbIntentLatency, (FPlatformTime::Seconds() - ClimbIntentRequestTime) * 1000.0);
+        ClearClimbIntent();
+        return;
+    }
+
+    ClimbIntentTimeRemaining -= DeltaTime;
+    if (ClimbIntentTimeRemaining <= 0.f)
+    {
+        ClearClimbIntent();
+        INC_DWORD_STAT(STAT_ClimbIntentsExpired);
+        UE_LOG(LogTemp, Verbose, TEXT("%s: climb intent expired without a climbable surface"), *GetNameSafe(CharacterOwner));
+    }
+}
+
+void UCustomMovementComponent::ClearClimbIntent()
+{
+    bClimbIntentPending = false;
+    ClimbIntentTimeRemaining = 0.f;
+    bHasFailedClimbStartProbe = false;
+}
+#pragma endregion
+
+#pragma region ClimbAutoTraversal
+void UCustomMovementComponent::UpdateAutoClimbTraversal(float DeltaTime)
+{
+    // The server must not decide on its own, its probe timing differs from the client's
+    if (!bAutoClimbTraversal || !CharacterOwner->IsLocallyControlled()) return;
+
+    AutoClimbProbeTimer -= DeltaTime;
+
+    // Nothing climbable in range or not heading into anything, no queries at all
+    if (!bNearClimbableSurface || !ShouldProbeAutoClimbTraversal())
+    {
+        AutoClimbStage = EClimbAutoTraversalStage::Idle;
+        return;
+    }
+
+    if (AutoClimbStage == EClimbAutoTraversalStage::Idle)
+    {
+        if (AutoClimbProbeTimer > 0.f) return;
+
+        AutoClimbProbeTimer = AutoClimbProbeInterval;
+        AutoClimbStage = EClimbAutoTraversalStage::WallAhead;
+    }
+
+    const bool bFalling{IsFalling()};
+    const FVector ComponentLocation{UpdatedComponent->GetComponentLocation()};
+    const FVector ForwardVector{UpdatedComponent->GetForwardVector()};
+
+    // One query per frame, each step only runs if the one before found something
+    switch (AutoClimbStage)
+    {
+    case EClimbAutoTraversalStage::WallAhead:
+    {
+        INC_DWORD_STAT(STAT_ClimbAutoTraversalQueries);
+
+        // Running mantles what blocks the waist, falling grabs what is in front of the eyes
+        const bool bWallAhead{bFalling ? TraceFromEyeHeight(AutoClimbReach).bBlockingHit :
+            DoLineTraceSingleByObject(ComponentLocation, ComponentLocation + ForwardVector * AutoClimbReach).bBlockingHit};
+
+        AutoClimbStage = !bWallAhead ? EClimbAutoTraversalStage::Idle :
+            bFalling ? EClimbAutoTraversalStage::LedgeGrab : EClimbAutoTraversalStage::Clearance;
+        break;
+    }
+
+    case EClimbAutoTraversalStage::Clearance:
+        INC_DWORD_STAT(STAT_ClimbAutoTraversalQueries);
+
+        // Walls reaching above the eyes are climbed, not mantled
+        AutoClimbStage = TraceFromEyeHeight(AutoClimbReach).bBlockingHit ?
+            EClimbAutoTraversalStage::Idle : EClimbAutoTraversalStage::MantleTop;
+        break;
+
+    case EClimbAutoTraversalStage::MantleTop:
+        INC_DWORD_STAT(STAT_ClimbAutoTraversalQueries);
+
+        bWantsAutoMantle = TraceAutoMantleTop();
+        AutoClimbStage = EClimbAutoTraversalStage::Idle;
+        break;
+
+    case EClimbAutoTraversalStage::LedgeGrab:
+        // Confirmed by the ledge grab itself, counted there
+        bWantsAutoLedgeGrab = true;
+        AutoClimbStage = EClimbAutoTraversalStage::Idle;
+        break;
+
+    default:
+        AutoClimbStage = EClimbAutoTraversalStage::Idle;
+        break;
+    }
+}
+
+bool UCustomMovementComponent::TraceAutoMantleTop()
+{
+    const FVector UpVector{UpdatedComponent->GetUpVector()};
+    const FVector TopTraceStart{UpdatedComponent->GetComponentLocation() + UpdatedComponent->GetForwardVector() * AutoClimbReach +
+        UpVector * CharacterOwner->BaseEyeHeight};
+    const FVector TopTraceEnd{TopTraceStart - UpVector * CharacterOwner->BaseEyeHeight};
+
+    const FHitResult TopHit{DoLineTraceSingleByObject(TopTraceStart, TopTraceEnd)};
+
+    return TopHit.bBlockingHit && IsWalkable(TopHit);
+}
+
+void UCustomMovementComponent::PerformAutoClimbTraversal()
+{
+    if (!bWantsAutoMantle && !bWantsAutoLedgeGrab) return;
+
+    const uint32 QueriesBefore{NumClimbQueriesIssued};
+
+    if (bWantsAutoMantle)
+    {
+        // The server checks the top again rather than trusting the client
+        const bool bCanMantle{CharacterOwner->IsLocallyControlled() || TraceAutoMantleTop()};
+
+        // A replayed move finds the mantle it started the first time still running, only the
+        // mode change has to be done again
+        const bool bReplayingMantle{CharacterOwner->bClientUpdating && IsPlayingClimbTransition()};
+
+        // Mantle in flying mode so the root motion is applied vertically as well
+        if (bCanMantle && (bReplayingMantle || PlayClimbMontage(ClimbToTopMontage)))
+        {
+            SetMovementMode(MOVE_Flying);
+        }
+    }
+    else
+    {
+        TryStartLedgeHang();
+    }
+
+    bWantsAutoMantle = false;
+    bWantsAutoLedgeGrab = false;
+
+    INC_DWORD_STAT_BY(STAT_ClimbAutoTraversalQueries, NumClimbQueriesIssued - QueriesBefore);
+}
+
+bool UCustomMovementComponent::ShouldProbeAutoClimbTraversal() const
+{
+    if (IsPlayingClimbTransition()) return false;
+    if (OwningPlayerAnimInstance && OwningPlayerAnimInstance->IsAnyMontagePlaying()) return false;
+
+    const float ForwardSpeed{static_cast<float>(FVector::DotProduct(Velocity, UpdatedComponent->GetForwardVector()))};
+
+    if (IsMovingOnGround())
+    {
+        return ForwardSpeed >= AutoMantleMinSpeed;
+    }
+
+    // Ledges are only grabbed on the way down, never while jumping past them
+    if (IsFalling())
+    {
+        return Velocity.Z <= 0.f && ForwardSpeed >= 0.f;
+    }
+
+    return false;
+}
+#pragma endregion
+
+#pragma region ClimbMontageStreaming
+void UCustomMovementComponent::UpdateClimbProximity(float DeltaTime)
+{
+    if (ClimbableSurfaceTraceTypes.IsEmpty() && !bUseClimbableTraceChannel) return;
+
+    // Once the montages are resident only auto traversal still needs the answer
+    if (ClimbMontageLoadHandle.IsValid() && !bAutoClimbTraversal) return;
+
+    ClimbMontagePreloadCheckTimer -= DeltaTime;
+    if (ClimbMontagePreloadCheckTimer > 0.f) return;
+
+    ClimbMontagePreloadCheckTimer = ClimbMontagePreloadCheckInterval;
+
+    FCollisionQueryParams QueryParams{SCENE_QUERY_STAT(ClimbMontagePreload), false, CharacterOwner};
+
+    const FCollisionShape ProximityShape{FCollisionShape::MakeSphere(ClimbMontagePreloadRadius)};
+
+    bNearClimbableSurface = bUseClimbableTraceChannel ?
+        GetWorld()->OverlapAnyTestByChannel(UpdatedComponent->GetComponentLocation(), FQuat::Identity,
+            ECC_Climbable, ProximityShape, QueryParams) :
+        GetWorld()->OverlapAnyTestByObjectType(UpdatedComponent->GetComponentLocation(), FQuat::Identity,
+            FCollisionObjectQueryParams(ClimbableSurfaceTraceTypes), ProximityShape, QueryParams);
+
+    INC_DWORD_STAT(STAT_ClimbQueriesIssued);
+
+    if (bNearClimbableSurface)
+    {
+        RequestClimbMontagePreload();
+    }
+}
+
+void UCustomMovementComponent::RequestClimbMontagePreload()
+{
+    if (ClimbMontageLoadHandle.IsValid()) return;
+
+    TArray<FSoftObjectPath> MontagePaths;
+    for (const TSoftObjectPtr<UAnimMontage>* Montage : {&IdleToClimbMontage, &ClimbToTopMontage, &ClimbDownLedgeMontage})
+    {
+        if (!Montage->IsNull())
+        {
+            MontagePaths.AddUnique(Montage->ToSoftObjectPath());
+        }
+    }
+
+    if (MontagePaths.IsEmpty()) return;
+
+    ClimbMontageLoadRequestTime = FPlatformTime::Seconds();
+    ClimbMontageLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        MontagePaths,
+        FStreamableDelegate::CreateUObject(this, &UCustomMovementComponent::OnClimbMontagesLoaded));
+}
+
+void UCustomMovementComponent::OnClimbMontagesLoaded()
+{
+    const double LoadLatencyMs{(FPlatformTime::Seconds() - ClimbMontageLoadRequestTime) * 1000.0};
+
+    SET_FLOAT_STAT(STAT_ClimbMontageLoadLatency, LoadLatencyMs);
+    UE_LOG(LogTemp, Verbose, TEXT("%s: climb montages streamed in %.1f ms"),
+        *GetNameSafe(CharacterOwner), LoadLatencyMs);
+}
+
+UAnimMontage* UCustomMovementComponent::ResolveClimbMontage(const TSoftObjectPtr<UAnimMontage>& Montage)
+{
+    if (UAnimMontage* LoadedMontage = Montage.Get())
+    {
+        return LoadedMontage;
+    }
+
+    // Climbing started before the preload finished (or was never triggered), block rather than skip the montage
+    RequestClimbMontagePreload();
+
+    INC_DWORD_STAT(STAT_ClimbMontageSyncLoads);
+    UE_LOG(LogTemp, Warning, TEXT("%s: loading climb montage %s synchronously"),
+        *GetNameSafe(CharacterOwner), *Montage.ToString());
+
+    return Montage.LoadSynchronous();
+}
+#pragma endregion
+
+#pragma region ClimbWorldStreaming
+bool UCustomMovementComponent::ShouldHoldForClimbStreaming(float DeltaTime)
+{
+    // Only a surface that was there a moment ago can be missing because of streaming
+    const bool bCanHold{bClimbStreamingSourceRegistered && ClimbableSurfacesTraceResults.IsEmpty() &&
+        (IsClimbing() || IsLedgeHanging()) && !CurrentClimbableSurface.Normal.IsZero()};
+
+    if (!bCanHold)
+    {
+        bClimbSurfaceStreaming = false;
+        bHoldingForClimbStreaming = false;
+        ClimbStreamingHoldTime = 0.f;
+        return false;
+    }
+
+    ClimbStreamingHoldTime += DeltaTime;
+
+    // Past the timeout the surface is really gone, or loading has stalled, either way let go
+    bClimbSurfaceStreaming = ClimbStreamingHoldTime <= ClimbStreamingHoldTimeout && IsClimbSurfaceCellStreaming();
+
+    // The server decides the hold. A client missing a cell the server already has keeps climbing on the
+    // last surface, and a server hold reaches it as a correction
+    bHoldingForClimbStreaming = bClimbSurfaceStreaming && CharacterOwner->HasAuthority();
+
+    return bClimbSurfaceStreaming;
+}
+
+bool UCustomMovementComponent::IsClimbSurfaceCellStreaming() const
+{
+    const UWorldPartitionSubsystem* WorldPartitionSubsystem{GetWorld()->GetSubsystem<UWorldPartitionSubsystem>()};
+    if (!WorldPartitionSubsystem) return false;
+
+    // Only the cells under the surface the probe lost matter, the rest of the source may still be loading
+    FWorldPartitionStreamingQuerySource QuerySource{CurrentClimbableSurface.Location};
+    QuerySource.bUseGridLoadingRange = false;
+    QuerySource.Radius = ClimbCapsuleTraceRadius;
+
+    return !WorldPartitionSubsystem->IsStreamingCompleted(EWorldPartitionRuntimeCellState::Activated, {QuerySource}, false);
+}
+#pragma endregion
+
+#pragma region ClimbTelemetry
+void UCustomMovementComponent::CommitClimbTelemetry(FClimbTelemetryFrame& Frame)
+{
+    if (!ClimbTelemetry.IsEnabled()) return;
+
+    Frame.WorldTime = GetWorld()->GetTimeSeconds();
+    Frame.Location = FVector3f(UpdatedComponent->GetComponentLocation());
+    Frame.SurfaceNormal = FVector3f(CurrentClimbableSurface.Normal);
+    Frame.MovementMode = MovementMode;
+    Frame.CustomMovementMode = CustomMovementMode;
+
+    ClimbTelemetry.Record(Frame);
+}
+#pragma endregion
+
+bool FClimbStateSnapshot::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    bOutSuccess = true;
+
+    Ar << CustomMode;
+
+    // Nothing else means anything outside of climb traversal
+    if (!IsInClimbTraversal()) return true;
+
+    bOutSuccess &= SerializePackedVector<10, 24>(SurfaceLocation, Ar);
+    bOutSuccess &= SerializeFixedVector<1, 16>(SurfaceNormal, Ar);
+    bOutSuccess &= SerializePackedVector<10, 24>(Anchor, Ar);
+
+    uint8 bLedgeAbove{bHasLedgeAbove};
+    Ar.SerializeBits(&bLedgeAbove, 1);
+    bHasLedgeAbove = bLedgeAbove != 0;
+
+    Ar << ModeTimeRemaining;
+    Ar << WallRunSide;
+
+    return bOutSuccess;
+}
+
+void FClimbMoveResponseDataContainer::ServerFillResponseData(const UCharacterMovementComponent& CharacterMovement,
+    const FClientAdjustment& PendingAdjustment)
+{
+    FCharacterMoveResponseDataContainer::ServerFillResponseData(CharacterMovement, PendingAdjustment);
+
+    if (!PendingAdjustment.bAckGoodMove)
+    {
+        ClimbState = static_cast<const UCustomMovementComponent&>(CharacterMovement).CaptureClimbStateSnapshot();
+    }
+}
+
+bool FClimbMoveResponseDataContainer::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar,
+    UPackageMap* PackageMap)
+{
+    if (!FCharacterMoveResponseDataContainer::Serialize(CharacterMovement, Ar, PackageMap)) return false;
+
+    // Acknowledged moves need no climb state, keep them as small as before
+    if (IsCorrection())
+    {
+        bool bSuccess{true};
+        ClimbState.NetSerialize(Ar, PackageMap, bSuccess);
+        return bSuccess && !Ar.IsError();
+    }
+
+    return !Ar.IsError();
+}
+
+// Listed under [MemReportCommands] so every memreport gets a climbing section
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice ClimbMemReportCommand(
+    TEXT("climb.MemReport"),
+    TEXT("Lists per-climber memory owned by the climbing system"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(
+        [](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        Ar.Logf(TEXT("ClimbingSystem memory (FClimbSurfaceSample %d bytes, FHitResult %d bytes):"),
+            static_cast<int32>(sizeof(FClimbSurfaceSample)), static_cast<int32>(sizeof(FHitResult)));
+
+        int32 NumClimbers{0};
+        SIZE_T TotalBytes{0};
+
+        for (TObjectIterator<UCustomMovementComponent> It; It; ++It)
+        {
+            if (It->GetWorld() != World || It->IsTemplate()) continue;
+
+            const SIZE_T ClimberBytes{sizeof(UCustomMovementComponent) + It->GetClimbAllocatedSize()};
+
+            Ar.Logf(TEXT("  %-40s %8llu bytes (%llu heap)"),
+                *GetNameSafe(It->GetOwner()),
+                static_cast<uint64>(ClimberBytes),
+                static_cast<uint64>(It->GetClimbAllocatedSize()));
+
+            ++NumClimbers;
+            TotalBytes += ClimberBytes;
+        }
+
+        Ar.Logf(TEXT("  %d climbers, %llu bytes total"), NumClimbers, static_cast<uint64>(TotalBytes));
+    }));
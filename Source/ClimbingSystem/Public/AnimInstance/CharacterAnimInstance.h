@@ -1,53 +1,122 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Animation/AnimInstance.h"
-#include "CharacterAnimInstance.generated.h"
-
-class AClimbingSystemCharacter;
-class UCustomMovementComponent;
-/**
- * 
- */
-UCLASS()
-class CLIMBINGSYSTEM_API UCharacterAnimInstance : public UAnimInstance
-{
-	GENERATED_BODY()
-	
-public:
-	virtual void NativeInitializeAnimation() override;
-	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
-
-private:
-	UPROPERTY()
-	AClimbingSystemCharacter* ClimbingSystemCharacter;
-
-	UPROPERTY()
-	UCustomMovementComponent* CustomMovementComponent;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "tuue"))
-	float GroundSpeed;
-	void SetGroundSpeed();
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "tuue"))
-	float AirSpeed;
-	void SetAirSpeed();
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
-	bool bShouldMove;
-	void SetShouldMove();
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
-	bool bIsFalling;
-	void SetIsFalling();
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
-	bool bIsClimbing;
-	void SetIsClimbing();
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
-	FVector ClimbVelocity;
-	void SetClimbVelocity();
-};
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "CustomMovementComponent.h"
+#include "CharacterAnimInstance.generated.h"
+
+class AClimbingSystemCharacter;
+class UCustomMovementComponent;
+/**
+ * 
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UCharacterAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+	
+public:
+	virtual void NativeInitializeAnimation() override;
+	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+
+private:
+	UPROPERTY()
+	AClimbingSystemCharacter* ClimbingSystemCharacter;
+
+	UPROPERTY()
+	UCustomMovementComponent* CustomMovementComponent;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "tuue"))
+	float GroundSpeed;
+	void SetGroundSpeed();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "tuue"))
+	float AirSpeed;
+	void SetAirSpeed();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
+	bool bShouldMove;
+	void SetShouldMove();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
+	bool bIsFalling;
+	void SetIsFalling();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
+	bool bIsClimbing;
+	void SetIsClimbing();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
+	bool bIsLedgeHanging;
+	void SetIsLedgeHanging();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
+	bool bIsWallRunning;
+	void SetIsWallRunning();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
+	FVector ClimbVelocity;
+	void SetClimbVelocity();
+
+#pragma region ClimbIK
+	/**
+	 * Places hands and feet on the climbed surface
+	 *
+	 * Limbs inside the area the movement component probed are projected onto its hits. The
+	 * ones outside of it share a single sweep.
+	 */
+	void UpdateClimbIK(float DeltaSeconds);
+
+	/**
+	 * Bones whose animated location is projected onto the surface, in the order of the IK outputs
+	 *
+	 * Must follow the animation without being moved by the climb IK, otherwise the IK samples its own
+	 * output and the limbs freeze. The mannequin's ik_ bones are such unmodified copies of the limbs.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Climb IK")
+	FName LeftHandBone{TEXT("ik_hand_l")};
+
+	UPROPERTY(EditDefaultsOnly, Category = "Climb IK")
+	FName RightHandBone{TEXT("ik_hand_r")};
+
+	UPROPERTY(EditDefaultsOnly, Category = "Climb IK")
+	FName LeftFootBone{TEXT("ik_foot_l")};
+
+	UPROPERTY(EditDefaultsOnly, Category = "Climb IK")
+	FName RightFootBone{TEXT("ik_foot_r")};
+
+	/** Distance of the IK targets from the surface, roughly the thickness of a hand */
+	UPROPERTY(EditDefaultsOnly, Category = "Climb IK")
+	float ClimbIKSurfaceOffset{5.f};
+
+	/** How far past the surface the sweep for limbs outside of the probed area reaches */
+	UPROPERTY(EditDefaultsOnly, Category = "Climb IK")
+	float ClimbIKReach{40.f};
+
+	/** Interpolation speed of the IK targets and of the IK alpha */
+	UPROPERTY(EditDefaultsOnly, Category = "Climb IK")
+	float ClimbIKInterpSpeed{15.f};
+
+	/** World space IK targets, valid while ClimbIKAlpha is above zero */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climb IK", meta = (AllowPrivateAccess = "true"))
+	FVector LeftHandIKLocation;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climb IK", meta = (AllowPrivateAccess = "true"))
+	FVector RightHandIKLocation;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climb IK", meta = (AllowPrivateAccess = "true"))
+	FVector LeftFootIKLocation;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climb IK", meta = (AllowPrivateAccess = "true"))
+	FVector RightFootIKLocation;
+
+	/** Blend weight of the climb IK, eased in while climbing without a transition montage */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climb IK", meta = (AllowPrivateAccess = "true"))
+	float ClimbIKAlpha{0.f};
+
+	/** Scratch for the sweep of limbs outside of the probed area */
+	TArray<FClimbSurfaceSample> ClimbIKSweepSamples;
+#pragma endregion
+};
@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "ClimbAIController.generated.h"
+
+class AClimbingSystemCharacter;
+struct FClimbNavPath;
+
+/**
+ * AI controller that climbs where the navmesh has no way through
+ *
+ * MoveToLocationWithClimbing walks when the navmesh reaches the goal. Otherwise it follows a
+ * route from UClimbNavGraphSubsystem, walking between endpoints with the regular path
+ * following and climbing between them through ToggleToClimbing and climb input.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API AClimbAIController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AClimbAIController(const FObjectInitializer& ObjectInitializer);
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	/**
+	 * Moves to Goal, over climbable walls if needed
+	 * @return false if neither the navmesh nor the climb graph has a route there
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AI|Climbing")
+	bool MoveToLocationWithClimbing(const FVector& Goal);
+
+	/** Stops walking and climbing towards the current goal, the character lets go of the wall */
+	UFUNCTION(BlueprintCallable, Category = "AI|Climbing")
+	void StopClimbMove();
+
+protected:
+	virtual void OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result) override;
+
+private:
+	enum class EClimbMoveState : uint8
+	{
+		Idle,
+		/** The climb graph is still being built, the request is retried every tick */
+		WaitingForGraph,
+		/** Path following towards the next endpoint or the goal */
+		Walking,
+		/** Getting onto, along or off a wall */
+		Climbing
+	};
+
+	/** Looks up the climb route to GoalLocation and starts following it, waits while the graph is not built yet */
+	bool FollowClimbRoute();
+
+	/** Heads for the next point of ClimbPath, or the goal once it is used up */
+	void AdvanceClimbPath();
+
+	void UpdateClimbing(float DeltaSeconds);
+
+	/** Climb input towards Target, expressed the way AClimbingSystemCharacter::AddMoveInput expects it */
+	FVector2D GetClimbInputTowards(const FVector& Target) const;
+
+	AClimbingSystemCharacter* GetClimbingCharacter() const;
+
+	/** Distance at which a climb point counts as reached */
+	UPROPERTY(EditDefaultsOnly, Category = "AI|Climbing")
+	float ClimbAcceptanceRadius{40.f};
+
+	/** Seconds without getting closer to the next point before the move is given up */
+	UPROPERTY(EditDefaultsOnly, Category = "AI|Climbing")
+	float ClimbStuckTime{3.f};
+
+	/** Seconds between climb requests while trying to get onto a wall */
+	UPROPERTY(EditDefaultsOnly, Category = "AI|Climbing")
+	float ClimbRequestInterval{0.5f};
+
+	EClimbMoveState MoveState{EClimbMoveState::Idle};
+
+	TSharedPtr<const FClimbNavPath> ClimbPath;
+
+	int32 ClimbPathIndex{0};
+
+	FVector GoalLocation{FVector::ZeroVector};
+
+	/** Closest the character got to the current point, and how long ago that was */
+	float BestDistanceToPoint{TNumericLimits<float>::Max()};
+
+	float StuckTimer{0.f};
+
+	float ClimbRequestTimer{0.f};
+};
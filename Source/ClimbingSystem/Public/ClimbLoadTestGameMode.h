@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbingSystem/ClimbingSystemGameMode.h"
+#include "ClimbLoadTestGameMode.generated.h"
+
+/**
+ * Game mode for headless climbing load tests
+ *
+ * Run the server with ?game=/Script/ClimbingSystem.ClimbLoadTestGameMode and connect
+ * clients started with -ClimbBot (see Scripts/ClimbLoadTest.sh). Every report interval
+ * the server logs its world tick time and, per client, corrections and bytes per second.
+ *
+ * Command line: -ClimbLoadTestReportInterval=<seconds> -ClimbLoadTestDuration=<seconds>
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API AClimbLoadTestGameMode : public AClimbingSystemGameMode
+{
+	GENERATED_BODY()
+
+public:
+	AClimbLoadTestGameMode();
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaTime);
+
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime);
+
+	void ReportLoadTest();
+
+	UPROPERTY(EditDefaultsOnly, Category = "Climb Load Test")
+	float ReportInterval{5.f};
+
+	/** Seconds before the server exits, 0 runs until killed */
+	UPROPERTY(EditDefaultsOnly, Category = "Climb Load Test")
+	float Duration{0.f};
+
+	FTimerHandle ReportTimerHandle;
+
+	FDelegateHandle TickStartHandle;
+
+	FDelegateHandle PostActorTickHandle;
+
+	double TickStartTime{0.0};
+
+	/** World tick time accumulated since the last report */
+	double TickSecondsTotal{0.0};
+
+	double TickSecondsMax{0.0};
+
+	int32 NumTicks{0};
+
+	/** Corrections per player controller at the last report, to print deltas */
+	TMap<TWeakObjectPtr<APlayerController>, uint32> LastReportedCorrections;
+};
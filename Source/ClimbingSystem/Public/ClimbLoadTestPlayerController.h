@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PlayerController.h"
+#include "ClimbLoadTestPlayerController.generated.h"
+
+class AClimbingSystemCharacter;
+
+/**
+ * Player controller that climbs on its own for server load tests
+ *
+ * On clients started with -ClimbBot the local controller loops through approaching a wall,
+ * climbing it (mantling at the top when there is a ledge), climbing back down and turning
+ * away. Everything goes through the same input and RPC path a real player uses.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API AClimbLoadTestPlayerController : public APlayerController
+{
+	GENERATED_BODY()
+
+public:
+	AClimbLoadTestPlayerController();
+
+	virtual void BeginPlay() override;
+
+	virtual void PlayerTick(float DeltaTime) override;
+
+private:
+	enum class EClimbBotState : uint8
+	{
+		Approach,
+		Climb,
+		Descend,
+		Turn
+	};
+
+	void EnterState(EClimbBotState NewState);
+
+	AClimbingSystemCharacter* GetClimbingCharacter() const;
+
+	/** Seconds spent running at a wall before giving up and turning */
+	UPROPERTY(EditDefaultsOnly, Category = "Climb Load Test")
+	float ApproachTime{4.f};
+
+	UPROPERTY(EditDefaultsOnly, Category = "Climb Load Test")
+	float ClimbTime{3.f};
+
+	UPROPERTY(EditDefaultsOnly, Category = "Climb Load Test")
+	float DescendTime{2.f};
+
+	/** Seconds between climb attempts while approaching */
+	UPROPERTY(EditDefaultsOnly, Category = "Climb Load Test")
+	float ClimbAttemptInterval{0.25f};
+
+	bool bIsClimbBot{false};
+
+	EClimbBotState BotState{EClimbBotState::Approach};
+
+	float StateTime{0.f};
+
+	float NextClimbAttemptTime{0.f};
+
+	/** Seeded per bot so a run can be reproduced */
+	FRandomStream BotRandom;
+};
@@ -0,0 +1,133 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MovementMode.h"
+#include "MovementModeTransition.h"
+#include "MoverTypes.h"
+#include "ClimbSurfaceMath.h"
+#include "ClimbMoverMode.generated.h"
+
+/** Climb input carried in the Mover input command next to FCharacterDefaultInputs */
+USTRUCT(BlueprintType)
+struct CLIMBINGSYSTEM_API FClimbMoverInputs : public FMoverDataStructBase
+{
+	GENERATED_BODY()
+
+	/** Climb pressed since the last produced input command, the simulation toggles climbing on it */
+	UPROPERTY(BlueprintReadWrite, Category = "Climbing")
+	bool bIsClimbToggleJustPressed{false};
+
+	virtual FMoverDataStructBase* Clone() const override;
+
+	virtual bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) override;
+
+	virtual UScriptStruct* GetScriptStruct() const override { return StaticStruct(); }
+
+	virtual void ToString(FAnsiStringBuilderBase& Out) const override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FClimbMoverInputs> : public TStructOpsTypeTraitsBase2<FClimbMoverInputs>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithCopy = true
+	};
+};
+
+/**
+ * Climb movement mode for the Mover plugin
+ *
+ * Port of UCustomMovementComponent::PhysClimb. It moves along the surface with the climb
+ * rotation and snaps back onto it, sharing the surface math through ClimbSurfaceMath. State
+ * lives in the Mover sync state and sim blackboard.
+ *
+ * Under UMoverNetworkPhysicsLiaisonComponent the simulation runs on the physics thread, where
+ * neither scene queries nor component moves are allowed. The owner therefore probes the surface
+ * on the game thread with RefreshSurface, the simulation reads the latest probe, and the mode
+ * only writes the target transform and velocity to the sync state for the liaison to apply to
+ * the physics body. On the game thread backends it moves UpdatedComponent itself.
+ */
+UCLASS(Blueprintable, BlueprintType)
+class CLIMBINGSYSTEM_API UClimbMoverMode : public UBaseMovementMode
+{
+	GENERATED_BODY()
+
+public:
+	UClimbMoverMode(const FObjectInitializer& ObjectInitializer);
+
+	//~ Begin UBaseMovementMode Interface
+	virtual void OnGenerateMove(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep,
+		FProposedMove& OutProposedMove) const override;
+
+	virtual void OnSimulationTick(const FSimulationTickParams& Params, FMoverTickEndData& OutputState) override;
+	//~ End UBaseMovementMode Interface
+
+	/** Probes the surface in front of UpdatedComponent for the next simulation steps, game thread only */
+	void RefreshSurface(const USceneComponent* UpdatedComponent);
+
+	/** @return true if the last probed surface can be climbed, safe from the simulation thread */
+	bool CanClimb() const;
+
+	/** Name this mode is registered under on the Mover component */
+	static const FName ModeName;
+
+	/** Sim blackboard key holding the last FClimbSurfaceInfo */
+	static const FName SurfaceBlackboardKey;
+
+	/** Object types considered climbable surfaces */
+	UPROPERTY(EditDefaultsOnly, Category = "Climbing")
+	TArray<TEnumAsByte<EObjectTypeQuery>> ClimbableSurfaceTraceTypes;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Climbing")
+	float ClimbCapsuleTraceRadius{50.f};
+
+	UPROPERTY(EditDefaultsOnly, Category = "Climbing")
+	float ClimbCapsuleTraceHalfHeight{72.f};
+
+	UPROPERTY(EditDefaultsOnly, Category = "Climbing", meta = (ClampMin = "0.0", ClampMax = "90.0"))
+	float ClimbSurfaceOutlierAngle{50.f};
+
+	UPROPERTY(EditDefaultsOnly, Category = "Climbing", meta = (ClampMin = "0.0"))
+	float ClimbSurfaceNormalSmoothingTime{0.08f};
+
+	UPROPERTY(EditDefaultsOnly, Category = "Climbing")
+	float MaxClimbSpeed{100.f};
+
+	/** Mode entered when the surface can no longer be climbed */
+	UPROPERTY(EditDefaultsOnly, Category = "Climbing")
+	FName FallbackModeName;
+
+private:
+	/** Sweeps the climb capsule forward and returns the surface estimate, zero normal if nothing was hit */
+	FClimbSurfaceInfo ProbeSurface(const USceneComponent* UpdatedComponent) const;
+
+	FClimbSurfaceInfo GetLatestSurface() const;
+
+	/** True when the physics liaison drives the body and the simulation must not move components */
+	bool IsPhysicsDriven() const;
+
+	/** Written by RefreshSurface on the game thread, read by the simulation */
+	FClimbSurfaceInfo LatestSurface;
+
+	mutable FCriticalSection LatestSurfaceLock;
+};
+
+/**
+ * Enters and leaves UClimbMoverMode when the input command carries a climb toggle
+ *
+ * Registered as a global transition on the Mover component so the mode change happens inside
+ * the simulation, and is predicted and replayed with the input, instead of being queued from
+ * the input handler.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbMoverToggleTransition : public UBaseMovementModeTransition
+{
+	GENERATED_BODY()
+
+public:
+	virtual FTransitionEvalResult OnEvaluate(const FSimulationTickParams& Params) const override;
+};
@@ -0,0 +1,259 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ClimbNavGraph.generated.h"
+
+class UPrimitiveComponent;
+
+/** Role of a climb graph node */
+enum class EClimbNavNodeType : uint8
+{
+	/** On a climbable wall */
+	Climb,
+	/** Walkable floor at the foot of a wall, climbing starts and ends here */
+	Ground,
+	/** Walkable top of a wall, reached by mantling */
+	Ledge
+};
+
+struct FClimbNavNode
+{
+	FVector Location{FVector::ZeroVector};
+
+	/** Wall normal for climb nodes, floor normal otherwise */
+	FVector3f Normal{FVector3f::UpVector};
+
+	EClimbNavNodeType Type{EClimbNavNodeType::Climb};
+
+	/** Range of this node's edges in FClimbNavGraph::Edges */
+	int32 FirstEdge{0};
+
+	int32 NumEdges{0};
+
+	FORCEINLINE bool IsEndpoint() const { return Type != EClimbNavNodeType::Climb; }
+};
+
+struct FClimbNavEdge
+{
+	int32 To{INDEX_NONE};
+
+	float Cost{0.f};
+};
+
+struct FClimbNavPathPoint
+{
+	FVector Location{FVector::ZeroVector};
+
+	FVector3f Normal{FVector3f::UpVector};
+
+	EClimbNavNodeType Type{EClimbNavNodeType::Climb};
+};
+
+/** Route across the climb graph, from a ground or ledge node to another one */
+struct FClimbNavPath
+{
+	TArray<FClimbNavPathPoint> Points;
+
+	float Cost{0.f};
+};
+
+/**
+ * Climb graph with A* search
+ *
+ * Nodes and edges are built with AddNode and AddEdge, then packed by Finalize into flat arrays
+ * and a spatial hash. Searches reuse scratch arrays stamped per query, so nothing is cleared
+ * or allocated between them.
+ */
+class CLIMBINGSYSTEM_API FClimbNavGraph
+{
+public:
+	void Reset();
+
+	int32 AddNode(const FVector& Location, const FVector& Normal, EClimbNavNodeType Type);
+
+	/** Adds an edge both ways, only valid before Finalize */
+	void AddEdge(int32 NodeA, int32 NodeB, float Cost);
+
+	/**
+	 * Links every endpoint to the endpoints within WalkLinkRadius and packs the graph
+	 * @param CellSize - Edge length of the spatial hash cells
+	 * @param WalkLinkRadius - Endpoints closer than this are assumed to be walkable between
+	 */
+	void Finalize(float CellSize, float WalkLinkRadius);
+
+	/** @return Closest node within MaxDistance, INDEX_NONE if there is none */
+	int32 FindNearestNode(const FVector& Location, float MaxDistance, bool bEndpointsOnly) const;
+
+	/**
+	 * A* from StartNode to GoalNode
+	 * @param OutNodes - Node indices along the path, start and goal included
+	 * @return false if GoalNode cannot be reached
+	 */
+	bool FindPath(int32 StartNode, int32 GoalNode, TArray<int32>& OutNodes, float& OutCost) const;
+
+	FORCEINLINE const TArray<FClimbNavNode>& GetNodes() const { return Nodes; }
+
+	FORCEINLINE TConstArrayView<FClimbNavEdge> GetEdges(int32 Node) const
+	{
+		return MakeArrayView(Edges.GetData() + Nodes[Node].FirstEdge, Nodes[Node].NumEdges);
+	}
+
+	FORCEINLINE bool IsEmpty() const { return Nodes.IsEmpty(); }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	FIntVector GetCell(const FVector& Location) const;
+
+	TArray<FClimbNavNode> Nodes;
+
+	TArray<FClimbNavEdge> Edges;
+
+	/** Edges per node while building, moved into Edges by Finalize */
+	TArray<TArray<FClimbNavEdge>> PendingEdges;
+
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	float CellSize{200.f};
+
+	/** A* scratch, entries are only valid where SearchStamps matches SearchStamp */
+	mutable TArray<float> CostSoFar;
+
+	mutable TArray<int32> CameFrom;
+
+	mutable TArray<uint32> SearchStamps;
+
+	mutable uint32 SearchStamp{0};
+};
+
+/**
+ * Climb navigation graph of the world
+ *
+ * Samples the static geometry matching the climbers' ClimbableSurfaceTraceTypes into climb,
+ * ground and ledge nodes, rebuilt time sliced whenever climbable geometry is added or removed.
+ * Path queries between endpoints are cached until the next rebuild.
+ */
+UCLASS(Config = Game)
+class CLIMBINGSYSTEM_API UClimbNavGraphSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UTickableWorldSubsystem Interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UTickableWorldSubsystem Interface
+
+	/**
+	 * Object types treated as climbable, changing them rebuilds the graph
+	 * @param bClimbableChannelOnly - Also require geometry to block ECC_Climbable, for climbers probing that channel
+	 */
+	void SetClimbableObjectTypes(const TArray<TEnumAsByte<EObjectTypeQuery>>& ObjectTypes, bool bClimbableChannelOnly = false);
+
+	/** Schedules a rebuild, for gameplay that changes climbable geometry without spawning or destroying actors */
+	void MarkGraphDirty();
+
+	/**
+	 * Finds a climb route between the endpoints nearest to Start and Goal
+	 * @return The cached path, nullptr if either end has no endpoint nearby or there is no route
+	 */
+	TSharedPtr<const FClimbNavPath> FindPath(const FVector& Start, const FVector& Goal);
+
+	FORCEINLINE const FClimbNavGraph& GetGraph() const { return Graph; }
+
+	/** Incremented every time a rebuilt graph is swapped in */
+	FORCEINLINE uint32 GetGraphVersion() const { return GraphVersion; }
+
+	/** Spacing of the climb nodes on a wall */
+	UPROPERTY(Config)
+	float NodeSpacing{75.f};
+
+	/** Distance of the climb nodes from the wall, roughly the climbing capsule radius */
+	UPROPERTY(Config)
+	float NodeSurfaceOffset{40.f};
+
+	/** Endpoints closer than this are linked by a walk */
+	UPROPERTY(Config)
+	float WalkLinkRadius{400.f};
+
+	/** Cost of climbing a distance relative to walking it */
+	UPROPERTY(Config)
+	float ClimbCostMultiplier{5.f};
+
+	/** How far from the query locations endpoints are looked for */
+	UPROPERTY(Config)
+	float EndpointSearchRadius{300.f};
+
+	/** Seconds after the last geometry change before rebuilding */
+	UPROPERTY(Config)
+	float RebuildDelay{0.5f};
+
+	/** Components sampled per tick while rebuilding */
+	UPROPERTY(Config)
+	int32 ComponentsPerTick{8};
+
+	/** Cached paths, the cache is flushed when it grows past this */
+	UPROPERTY(Config)
+	int32 MaxCachedPaths{4096};
+
+private:
+	void StartRebuild();
+
+	/** Samples the walls of Component into PendingGraph */
+	void SampleComponent(const UPrimitiveComponent* Component);
+
+	bool IsClimbableGeometry(const UPrimitiveComponent* Component) const;
+
+	bool HasClimbableGeometry(const AActor* Actor) const;
+
+	void OnActorSpawned(AActor* Actor);
+
+	void OnActorDestroyed(AActor* Actor);
+
+	void OnLevelChanged(ULevel* Level, UWorld* World);
+
+#if ENABLE_DRAW_DEBUG
+	void DrawGraph() const;
+#endif
+
+	FClimbNavGraph Graph;
+
+	/** Graph being rebuilt, swapped into Graph once every component is sampled */
+	FClimbNavGraph PendingGraph;
+
+	TArray<TWeakObjectPtr<const UPrimitiveComponent>> PendingComponents;
+
+	bool bRebuilding{false};
+
+	bool bGraphDirty{false};
+
+	float RebuildTimer{0.f};
+
+	uint32 GraphVersion{0};
+
+	TArray<TEnumAsByte<EObjectTypeQuery>> ClimbableObjectTypes;
+
+	bool bClimbableChannelOnly{false};
+
+	/** Start and goal node pair to path, nullptr entries remember unreachable pairs */
+	TMap<uint64, TSharedPtr<const FClimbNavPath>> PathCache;
+
+	FDelegateHandle ActorSpawnedHandle;
+
+	FDelegateHandle ActorDestroyedHandle;
+
+	FDelegateHandle LevelAddedHandle;
+
+	FDelegateHandle LevelRemovedHandle;
+};
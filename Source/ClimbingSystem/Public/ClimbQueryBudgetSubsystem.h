@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ClimbQueryBudgetSubsystem.generated.h"
+
+class UCustomMovementComponent;
+
+/**
+ * Frame-level budget for climb physics queries shared by every climber in the world
+ *
+ * Climbers are ranked once per frame (by distance to the nearest viewer, with aging so
+ * nobody starves). Climbers outside the budget keep using their cached surface data until
+ * their turn comes around. Player controlled climbers are exempt: their moves are predicted,
+ * so the server has to probe exactly when the client did.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbQueryBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UTickableWorldSubsystem Interface
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UTickableWorldSubsystem Interface
+
+	void RegisterClimber(UCustomMovementComponent* Climber);
+
+	void UnregisterClimber(UCustomMovementComponent* Climber);
+
+	/**
+	 * Consumes queries from this frame's budget
+	 * @param Climber - Component asking to probe
+	 * @param NumQueries - Number of physics queries the probe will issue
+	 * @return true if the climber may probe now, false if it should reuse cached results
+	 */
+	bool TryConsumeQueries(const UCustomMovementComponent* Climber, int32 NumQueries);
+
+private:
+	struct FClimberEntry
+	{
+		TWeakObjectPtr<UCustomMovementComponent> Climber;
+
+		float Priority{0.f};
+
+		/** Frames since this climber last got a probe, used for aging */
+		uint32 FramesSinceProbe{0};
+
+		/** Queries reserved for this climber in the current frame */
+		int32 GrantedQueries{0};
+
+		bool bActive{false};
+	};
+
+	/** Ranks active climbers and hands out next frame's grants */
+	void ScheduleQueries();
+
+	float CalculatePriority(const FClimberEntry& Entry) const;
+
+	TArray<FClimberEntry> Climbers;
+
+	/** Player view locations gathered each frame for distance ranking */
+	TArray<FVector> ViewLocations;
+
+	/** Climber to index in Climbers, rebuilt after every sort */
+	TMap<TObjectKey<UCustomMovementComponent>, int32> ClimberIndices;
+
+	/** Budget left over after grants, shared first come first served */
+	int32 SpareQueries{0};
+};
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "GameFramework/RootMotionSource.h"
+#include "ClimbRootMotionTable.generated.h"
+
+class UAnimMontage;
+class UClimbRootMotionTable;
+
+/** Root translation of one montage sampled at a fixed rate, in mesh space */
+USTRUCT()
+struct FClimbRootMotionTrack
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = "Root Motion")
+	TSoftObjectPtr<UAnimMontage> Montage;
+
+	UPROPERTY(VisibleAnywhere, Category = "Root Motion")
+	float PlayLength{0.f};
+
+	UPROPERTY(VisibleAnywhere, Category = "Root Motion")
+	float SampleRate{30.f};
+
+	/** Root translation accumulated from the start of the montage at every sample */
+	UPROPERTY(VisibleAnywhere, Category = "Root Motion")
+	TArray<FVector3f> Translations;
+
+	/** Accumulated root translation at Time, linearly interpolated between samples */
+	FVector SampleTranslation(float Time) const;
+};
+
+/**
+ * Root motion of the climb montages baked for playback without animation
+ *
+ * Lets dedicated servers drive climb transitions without evaluating the anim graph. Only
+ * the root translation is baked, climb montages are expected not to rotate the root.
+ */
+UCLASS(BlueprintType)
+class CLIMBINGSYSTEM_API UClimbRootMotionTable : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** @return the baked track of Montage, nullptr if it was not baked */
+	const FClimbRootMotionTrack* FindTrack(const TSoftObjectPtr<UAnimMontage>& Montage) const;
+
+	int32 FindTrackIndex(const TSoftObjectPtr<UAnimMontage>& Montage) const;
+
+	FORCEINLINE const FClimbRootMotionTrack* GetTrack(int32 TrackIndex) const
+	{
+		return Tracks.IsValidIndex(TrackIndex) ? &Tracks[TrackIndex] : nullptr;
+	}
+
+#if WITH_EDITOR
+	/** Extracts the root motion of every source montage into Tracks */
+	UFUNCTION(CallInEditor, Category = "Root Motion")
+	void BakeRootMotion();
+#endif
+
+#if WITH_EDITORONLY_DATA
+	UPROPERTY(EditAnywhere, Category = "Root Motion")
+	TArray<TSoftObjectPtr<UAnimMontage>> SourceMontages;
+
+	UPROPERTY(EditAnywhere, Category = "Root Motion", meta = (ClampMin = "1"))
+	float BakeSampleRate{30.f};
+#endif
+
+private:
+	UPROPERTY(VisibleAnywhere, Category = "Root Motion")
+	TArray<FClimbRootMotionTrack> Tracks;
+};
+
+/** Plays a baked climb root motion track as an override velocity */
+USTRUCT()
+struct CLIMBINGSYSTEM_API FRootMotionSource_ClimbTrack : public FRootMotionSource
+{
+	GENERATED_BODY()
+
+	FRootMotionSource_ClimbTrack();
+
+	virtual ~FRootMotionSource_ClimbTrack() {}
+
+	UPROPERTY()
+	TObjectPtr<UClimbRootMotionTable> Table;
+
+	UPROPERTY()
+	int32 TrackIndex{INDEX_NONE};
+
+	/** Mesh transform when the track started, maps mesh space root motion to world space */
+	UPROPERTY()
+	FTransform MeshTransform;
+
+	//~ Begin FRootMotionSource Interface
+	virtual FRootMotionSource* Clone() const override;
+
+	virtual bool Matches(const FRootMotionSource* Other) const override;
+
+	virtual bool MatchesAndHasSameState(const FRootMotionSource* Other) const override;
+
+	virtual bool UpdateStateFrom(const FRootMotionSource* SourceToTakeStateFrom, bool bMarkForSimulatedCatchup = false) override;
+
+	virtual void PrepareRootMotion(
+		float SimulationTime,
+		float MovementTickTime,
+		const ACharacter& Character,
+		const UCharacterMovementComponent& MoveComponent) override;
+
+	virtual bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) override;
+
+	virtual UScriptStruct* GetScriptStruct() const override;
+
+	virtual FString ToSimpleString() const override;
+
+	virtual void AddReferencedObjects(class FReferenceCollector& Collector) override;
+	//~ End FRootMotionSource Interface
+};
+
+template<>
+struct TStructOpsTypeTraits<FRootMotionSource_ClimbTrack> : public TStructOpsTypeTraitsBase2<FRootMotionSource_ClimbTrack>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithCopy = true
+	};
+};
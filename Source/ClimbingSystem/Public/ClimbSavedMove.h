@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CustomMovementComponent.h"
+
+/**
+ * Saved move of a climbing character
+ *
+ * Keeps the climb state the move started from and the surface probes it made, so replays after a
+ * correction can skip the traces while they stay on the recorded path.
+ */
+class CLIMBINGSYSTEM_API FSavedMove_Climb : public FSavedMove_Character
+{
+	using Super = FSavedMove_Character;
+
+public:
+	//~ Begin FSavedMove_Character Interface
+	virtual void Clear() override;
+
+	virtual void SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel,
+		FNetworkPredictionData_Client_Character& ClientData) override;
+
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+
+	virtual void CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC,
+		const FVector& OldStartLocation) override;
+
+	virtual void PrepMoveFor(ACharacter* Character) override;
+
+	virtual void PostUpdate(ACharacter* Character, EPostUpdateMode PostUpdateMode) override;
+
+	virtual uint8 GetCompressedFlags() const override;
+	//~ End FSavedMove_Character Interface
+
+	FClimbStateSnapshot StartClimbState;
+
+	/** Auto traversal decided by the client for this move, sent as FLAG_Custom_0 and FLAG_Custom_1 */
+	bool bWantsAutoMantle{false};
+
+	bool bWantsAutoLedgeGrab{false};
+
+	/** Climb hop or wall run jump requested for this move, sent as FLAG_Custom_2 */
+	bool bWantsClimbJump{false};
+
+	/** One record per climb update performed by this move */
+	TArray<FClimbProbeRecord> ClimbProbes;
+};
+
+/** Client prediction data allocating FSavedMove_Climb */
+class CLIMBINGSYSTEM_API FNetworkPredictionData_Client_Climb : public FNetworkPredictionData_Client_Character
+{
+	using Super = FNetworkPredictionData_Client_Character;
+
+public:
+	explicit FNetworkPredictionData_Client_Climb(const UCharacterMovementComponent& ClientMovement);
+
+	//~ Begin FNetworkPredictionData_Client_Character Interface
+	virtual FSavedMovePtr AllocateNewMove() override;
+	//~ End FNetworkPredictionData_Client_Character Interface
+};
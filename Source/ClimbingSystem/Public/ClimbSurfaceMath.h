@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CustomMovementComponent.h"
+
+/**
+ * Climb surface math shared by every movement backend
+ *
+ * Stateless so the character movement component and the Mover climb mode run exactly the
+ * same estimate, rotation and snap logic.
+ */
+namespace ClimbSurfaceMath
+{
+	/** Surfaces whose normal is within 60 degrees of world up are floors, not walls */
+	inline constexpr float StopAngleCos{0.5f};
+
+	/**
+	 * Averages probe samples into one surface, weighting closer hits higher and dropping outliers
+	 * @param Samples - Probe hits, may be empty
+	 * @param Origin - Location the probe was taken from
+	 * @param OutlierAngle - Hits further than this from the mean normal are ignored, in degrees
+	 * @return The estimated surface, zero location and normal if there were no samples
+	 */
+	CLIMBINGSYSTEM_API FClimbSurfaceInfo EstimateSurface(TConstArrayView<FClimbSurfaceSample> Samples,
+		const FVector& Origin, float OutlierAngle);
+
+	/** Low passes a surface normal, returns NewNormal unchanged when the filter cannot apply */
+	CLIMBINGSYSTEM_API FVector SmoothNormal(const FVector& PreviousNormal, const FVector& NewNormal,
+		float DeltaTime, float SmoothingTime);
+
+	/** Rotation facing into the surface, Fallback when there is no surface */
+	FORCEINLINE FQuat GetSurfaceRotation(const FVector& SurfaceNormal, const FQuat& Fallback)
+	{
+		return SurfaceNormal.IsZero() ? Fallback : FRotationMatrix::MakeFromX(-SurfaceNormal).ToQuat();
+	}
+
+	/** Offset pulling the climber onto the surface along its normal */
+	FORCEINLINE FVector GetSnapVector(const FClimbSurfaceInfo& Surface, const FVector& Location, const FVector& ProbeDirection)
+	{
+		const FVector ProjectedToSurface{(Surface.Location - Location).ProjectOnTo(ProbeDirection)};
+
+		return -Surface.Normal * ProjectedToSurface.Length();
+	}
+}
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "ClimbSurfacePhysicalMaterial.generated.h"
+
+/** Climbing properties of a surface, resolved from its physical material */
+struct FClimbSurfaceProperties
+{
+	/** Scale of MaxClimbSpeed */
+	float SpeedScale{1.f};
+
+	/** Scale of MaxClimbAcceleration and MaxBreakClimbDeceleration */
+	float Grip{1.f};
+
+	/** Surfaces whose normal has a larger dot product with world up than this stop the climb, 60 degrees by default */
+	float StopAngleCos{0.5f};
+
+	/** Most restrictive combination of two surfaces, used where a probe hits several */
+	static FClimbSurfaceProperties Combine(const FClimbSurfaceProperties& A, const FClimbSurfaceProperties& B);
+};
+
+/**
+ * Physical material with climbing properties
+ *
+ * Assign it to climbable meshes to climb them slower, with less grip or only when steeper than
+ * usual. Surfaces with any other physical material use the defaults.
+ */
+UCLASS(BlueprintType)
+class CLIMBINGSYSTEM_API UClimbSurfacePhysicalMaterial : public UPhysicalMaterial
+{
+	GENERATED_BODY()
+
+public:
+	/** Properties of PhysicalMaterial, the defaults if it is not a UClimbSurfacePhysicalMaterial */
+	static FClimbSurfaceProperties GetClimbSurfaceProperties(const UPhysicalMaterial* PhysicalMaterial);
+
+	/** Scale of the climbing speed on this surface */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climbing", meta = (ClampMin = "0.0"))
+	float ClimbSpeedScale{1.f};
+
+	/** Scale of the climbing acceleration and braking on this surface, lower slips more */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climbing", meta = (ClampMin = "0.0"))
+	float ClimbGrip{1.f};
+
+	/** Surfaces whose normal is within this angle of world up are floors, not walls (degrees) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climbing", meta = (ClampMin = "0.0", ClampMax = "90.0"))
+	float ClimbStopAngle{60.f};
+};
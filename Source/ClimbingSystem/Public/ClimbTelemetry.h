@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/LineBatchComponent.h"
+#include <atomic>
+
+/** Flags describing what happened during a recorded climb update */
+namespace EClimbTelemetryFlags
+{
+	enum Type : uint8
+	{
+		None = 0,
+		Probed = 1 << 0,
+		ModeChanged = 1 << 1,
+		ReachedFloor = 1 << 2,
+		ReachedLedge = 1 << 3,
+		ShouldStop = 1 << 4,
+		ReplayedProbe = 1 << 5,
+		StreamingHold = 1 << 6,
+	};
+}
+
+/**
+ * One climb update worth of telemetry
+ *
+ * Kept trivially copyable so a whole buffer can be dumped as raw bytes.
+ */
+struct FClimbTelemetryFrame
+{
+	double WorldTime{0.0};
+
+	FVector3f Location{FVector3f::ZeroVector};
+
+	FVector3f SurfaceNormal{FVector3f::ZeroVector};
+
+	FVector3f SnapVector{FVector3f::ZeroVector};
+
+	/** Cosine of the angle between the surface normal and world up */
+	float SurfaceUpDot{0.f};
+
+	uint16 NumProbeHits{0};
+
+	uint8 MovementMode{0};
+
+	uint8 CustomMovementMode{0};
+
+	/** Mode before a transition, only meaningful with EClimbTelemetryFlags::ModeChanged */
+	uint8 PreviousMovementMode{0};
+
+	uint8 PreviousCustomMovementMode{0};
+
+	uint8 Flags{EClimbTelemetryFlags::None};
+};
+
+/**
+ * Fixed size ring buffer of the last climb updates
+ *
+ * Single producer (the owning movement component), readers never block it. All memory is
+ * allocated once in Initialize.
+ */
+class CLIMBINGSYSTEM_API FClimbTelemetryRingBuffer
+{
+public:
+	/** Allocates room for Capacity frames, 0 disables recording */
+	void Initialize(int32 Capacity);
+
+	void Record(const FClimbTelemetryFrame& Frame);
+
+	/** Copies recorded frames into OutFrames, oldest first */
+	void CopyFrames(TArray<FClimbTelemetryFrame>& OutFrames) const;
+
+	/**
+	 * Writes the buffer to a binary file
+	 * @param Filename - Absolute path of the dump file
+	 * @return true if the file was written
+	 */
+	bool SaveToFile(const FString& Filename) const;
+
+	FORCEINLINE bool IsEnabled() const { return !Frames.IsEmpty(); }
+
+	FORCEINLINE SIZE_T GetAllocatedSize() const { return Frames.GetAllocatedSize(); }
+
+private:
+	TArray<FClimbTelemetryFrame> Frames;
+
+	/** Total frames ever recorded, the next slot is WriteCount % Frames.Num() */
+	std::atomic<uint32> WriteCount{0};
+};
+
+/** Draws a telemetry buffer through preallocated line batches */
+class CLIMBINGSYSTEM_API FClimbTelemetryDebugRenderer
+{
+public:
+	void Draw(UWorld* World, const FClimbTelemetryRingBuffer& Telemetry);
+
+	FORCEINLINE SIZE_T GetAllocatedSize() const { return FrameScratch.GetAllocatedSize() + Lines.GetAllocatedSize(); }
+
+private:
+	/** Reused every draw so drawing does not allocate once warmed up */
+	TArray<FClimbTelemetryFrame> FrameScratch;
+
+	TArray<FBatchedLine> Lines;
+};
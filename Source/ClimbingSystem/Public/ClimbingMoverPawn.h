@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Pawn.h"
+#include "MoverSimulationTypes.h"
+#include "ClimbingMoverPawn.generated.h"
+
+class UCapsuleComponent;
+class USkeletalMeshComponent;
+class UMoverComponent;
+class UClimbMoverMode;
+class USpringArmComponent;
+class UCameraComponent;
+class UInputMappingContext;
+class UInputAction;
+struct FInputActionValue;
+
+/**
+ * Climbing pawn driven by the Mover plugin instead of UCustomMovementComponent
+ *
+ * Walks and falls with the physics driven Mover modes and climbs with UClimbMoverMode, all
+ * simulated on the async physics thread through UMoverNetworkPhysicsLiaisonComponent. Selected
+ * over AClimbingSystemCharacter with climb.MovementBackend 1. Players drive it with the
+ * same third person input actions and follow camera as the character.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API AClimbingMoverPawn : public APawn, public IMoverInputProducerInterface
+{
+	GENERATED_BODY()
+
+public:
+	AClimbingMoverPawn(const FObjectInitializer& ObjectInitializer);
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
+
+	//~ Begin IMoverInputProducerInterface Interface
+	virtual void ProduceInput_Implementation(int32 SimTimeMs, FMoverInputCmdContext& InputCmdResult) override;
+	//~ End IMoverInputProducerInterface Interface
+
+	/**
+	 * Asks the simulation to start climbing if there is a climbable surface ahead, or to let go
+	 * of the wall. Sent with the next input command, UClimbMoverToggleTransition applies it.
+	 */
+	void RequestToggleClimbing(bool bEnableClimb);
+
+	bool IsClimbing() const;
+
+	FORCEINLINE UMoverComponent* GetMoverComponent() const { return MoverComponent; }
+
+private:
+	void Move(const FInputActionValue& Value);
+
+	void Look(const FInputActionValue& Value);
+
+	void OnJumpActionStarted(const FInputActionValue& Value);
+
+	void OnJumpActionCompleted(const FInputActionValue& Value);
+
+	void OnClimbActionStarted(const FInputActionValue& Value);
+
+	/** Held jump, forwarded to the Mover modes through FCharacterDefaultInputs */
+	bool bJumpPressed{false};
+
+	/** Jump pressed since the last produced input command */
+	bool bJumpJustPressed{false};
+
+	/** Climb toggle requested since the last produced input command, forwarded through FClimbMoverInputs */
+	bool bClimbToggleJustPressed{false};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Mover", meta = (AllowPrivateAccess = "true"))
+	UCapsuleComponent* CapsuleComponent;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Mover", meta = (AllowPrivateAccess = "true"))
+	USkeletalMeshComponent* Mesh;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Mover", meta = (AllowPrivateAccess = "true"))
+	UMoverComponent* MoverComponent;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	USpringArmComponent* CameraBoom;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	UCameraComponent* FollowCamera;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	UInputMappingContext* DefaultMappingContext;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	UInputAction* JumpAction;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	UInputAction* MoveAction;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	UInputAction* LookAction;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	UInputAction* ClimbAction;
+
+	UPROPERTY()
+	UClimbMoverMode* ClimbMode;
+};
@@ -0,0 +1,169 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BasicReplicationGraph.h"
+#include "ClimbingReplicationGraph.generated.h"
+
+class UCustomMovementComponent;
+
+/**
+ * Spatialization for characters using UCustomMovementComponent
+ *
+ * Climbers are bucketed in 3D cells so a crowd stacked up a tower is not relevant to
+ * everyone standing around its base. Climbers far away or well above/below a viewer keep
+ * their channel but replicate at a lower rate. Characters on the ground are bucketed in
+ * 2D columns and treated like the default grid would.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UReplicationGraphNode_ClimbSpatialization3D : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UReplicationGraphNode_ClimbSpatialization3D();
+
+	//~ Begin UReplicationGraphNode Interface
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+
+	virtual void NotifyResetAllNetworkActors() override;
+
+	virtual void PrepareForReplication() override;
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	virtual void LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const override;
+	//~ End UReplicationGraphNode Interface
+
+	/** Appends a per-connection summary of the last gather to Ar */
+	void ReportStats(FOutputDevice& Ar) const;
+
+	/** Edge length of a spatial cell */
+	float CellSize{2000.f};
+
+	/** Climbers further than this from every viewer replicate at a reduced rate */
+	float FullRateDistance{3000.f};
+
+	/** Climbers this far above or below a viewer count as vertically occluded */
+	float VerticalOcclusionHeight{800.f};
+
+	/** Replication period, in frames, of distant or vertically occluded climbers */
+	uint8 ReducedRatePeriodFrames{3};
+
+private:
+	struct FClimberActor
+	{
+		FActorRepListType Actor;
+
+		TWeakObjectPtr<UCustomMovementComponent> MovementComponent;
+
+		/** Gather pass this actor was last added in, dedupes split screen viewers */
+		uint32 LastGatherId{0};
+	};
+
+	struct FConnectionGatherStats
+	{
+		FString ConnectionName;
+
+		int32 NumRelevant{0};
+
+		int32 NumReducedRate{0};
+
+		double GatherSeconds{0.0};
+	};
+
+	FORCEINLINE FIntVector GetCell(const FVector& Location) const
+	{
+		return FIntVector(
+			FMath::FloorToInt32(Location.X / CellSize),
+			FMath::FloorToInt32(Location.Y / CellSize),
+			FMath::FloorToInt32(Location.Z / CellSize));
+	}
+
+	void GatherFromCell(const TArray<int32>* CellActors, const FNetViewer& Viewer,
+		const FConnectionGatherActorListParameters& Params, FConnectionGatherStats& Stats);
+
+	TArray<FClimberActor> Climbers;
+
+	/** Indices into Climbers of climbing characters, rebuilt every frame */
+	TMap<FIntVector, TArray<int32>> ClimbingCells;
+
+	/** Indices into Climbers of characters not climbing, Z is always 0 */
+	TMap<FIntVector, TArray<int32>> GroundCells;
+
+	/** Reused across connections, each connection replicates before the next one gathers */
+	FActorRepListRefView GatheredActors;
+
+	uint32 GatherId{0};
+
+	/** Cells searched around each viewer on every axis, covers the largest cull distance */
+	int32 CellSearchRadius{1};
+
+	FORCEINLINE bool IsWithinSearchRadius(const FIntVector& Cell, const FIntVector& ViewerCell) const
+	{
+		const FIntVector Offset{Cell - ViewerCell};
+		return FMath::Max3(FMath::Abs(Offset.X), FMath::Abs(Offset.Y), FMath::Abs(Offset.Z)) <= CellSearchRadius;
+	}
+
+	TArray<FConnectionGatherStats> LastFrameStats;
+
+	uint32 LastStatsFrame{0};
+};
+
+/**
+ * Replication graph for the climbing sample
+ *
+ * Same as UBasicReplicationGraph except climbing characters are routed to a
+ * UReplicationGraphNode_ClimbSpatialization3D instead of the 2D grid. Starting the server with
+ * -dpcvars=climb.RepGraph.ClimbNode=0 routes them to the 2D grid as well, for comparisons.
+ */
+UCLASS(transient, config = Engine)
+class CLIMBINGSYSTEM_API UClimbingReplicationGraph : public UBasicReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UReplicationGraph Interface
+	virtual void InitGlobalGraphNodes() override;
+
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+	//~ End UReplicationGraph Interface
+
+	/** nullptr when the graph runs without the climb node */
+	FORCEINLINE UReplicationGraphNode_ClimbSpatialization3D* GetClimbNode() const { return ClimbNode; }
+
+	/**
+	 * Average time spent replicating actors since the last call, then starts a new average
+	 * @param OutNumFrames - Replication frames the average covers
+	 */
+	double ConsumeAverageReplicateSeconds(int32& OutNumFrames);
+
+	UPROPERTY(config)
+	float ClimbCellSize{2000.f};
+
+	UPROPERTY(config)
+	float ClimbFullRateDistance{3000.f};
+
+	UPROPERTY(config)
+	float ClimbVerticalOcclusionHeight{800.f};
+
+	UPROPERTY(config)
+	uint8 ClimbReducedRatePeriodFrames{3};
+
+private:
+	static bool IsClimbingCharacter(const AActor* Actor);
+
+	UPROPERTY()
+	UReplicationGraphNode_ClimbSpatialization3D* ClimbNode;
+
+	double ReplicateSecondsTotal{0.0};
+
+	int32 NumReplicateFrames{0};
+};
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class UPrimitiveComponent;
+class UInstancedStaticMeshComponent;
+struct FHitResult;
+
+/**
+ * Opt-in trace channel blocked only by climbable geometry
+ *
+ * Ignored by default, climbable meshes block it through the ClimbableStatic collision profile
+ * or the climb.TagClimbable editor command. Declared in DefaultEngine.ini.
+ */
+#define ECC_Climbable ECC_GameTraceChannel1
+
+/** Bits of the flags custom data float of a climbable instance */
+namespace EClimbInstanceFlags
+{
+	enum Type : uint8
+	{
+		None = 0,
+		NotClimbable = 1 << 0,
+	};
+}
+
+/**
+ * Climb metadata of one instance of an instanced static mesh
+ *
+ * Stored in the last NumInstanceClimbDataFloats per-instance custom data floats as flags, speed
+ * scale and grip. Zeroed custom data reads as a climbable instance using its material's properties.
+ */
+struct FClimbInstanceData
+{
+	uint8 Flags{EClimbInstanceFlags::None};
+
+	/** Multipliers on the properties of the surface material */
+	float SpeedScale{1.f};
+
+	float Grip{1.f};
+
+	FORCEINLINE bool IsClimbable() const { return !(Flags & EClimbInstanceFlags::NotClimbable); }
+};
+
+namespace ClimbingSystemCollision
+{
+	/** Collision profile of static climbable geometry, BlockAll that also blocks ECC_Climbable */
+	inline const FName ClimbableProfileName{TEXT("ClimbableStatic")};
+
+	/**
+	 * Whether Component looks climbable: static, blocking, tall enough and with a steep side
+	 * @param MinHeight - Minimum height of the component bounds (cm)
+	 */
+	CLIMBINGSYSTEM_API bool IsClimbableCandidate(const UPrimitiveComponent* Component, float MinHeight);
+
+	/** Component tag of instanced meshes whose instances carry FClimbInstanceData in their custom data */
+	inline const FName ClimbInstanceDataTag{TEXT("ClimbInstanceData")};
+
+	/** Custom data floats taken by FClimbInstanceData, the last ones so material parameters keep their indices */
+	inline constexpr int32 NumInstanceClimbDataFloats{3};
+
+	/** Component as an instanced mesh carrying climb data, nullptr otherwise */
+	CLIMBINGSYSTEM_API const UInstancedStaticMeshComponent* GetClimbDataInstancedComponent(const UPrimitiveComponent* Component);
+
+	/**
+	 * Reads the climb data of one instance, straight from its custom data
+	 * @param InstanceIndex - Instance index, the Item of a hit on the component
+	 * @return false and defaults if the component or instance has no climb data
+	 */
+	CLIMBINGSYSTEM_API bool GetInstanceClimbData(const UInstancedStaticMeshComponent* Component, int32 InstanceIndex,
+		FClimbInstanceData& OutData);
+
+	/** False only for hits on instances flagged NotClimbable */
+	CLIMBINGSYSTEM_API bool IsClimbableHit(const FHitResult& Hit);
+
+	/**
+	 * Writes the climb data of one instance and tags the component with ClimbInstanceDataTag
+	 * @return false if the component has fewer than NumInstanceClimbDataFloats custom data floats
+	 */
+	CLIMBINGSYSTEM_API bool SetInstanceClimbData(UInstancedStaticMeshComponent* Component, int32 InstanceIndex,
+		const FClimbInstanceData& Data, bool bMarkRenderStateDirty = true);
+}
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/** LLM tag for climbing allocations, inspect with -LLM and "stat LLMFULL" */
+LLM_DECLARE_TAG_API(ClimbingSystem, CLIMBINGSYSTEM_API);
+
+/** Stats for the climbing system, inspect with "stat Climbing" */
+DECLARE_STATS_GROUP(TEXT("Climbing"), STATGROUP_Climbing, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Queries Issued"), STAT_ClimbQueriesIssued, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Probes Deferred"), STAT_ClimbProbesDeferred, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Slide Iterations"), STAT_ClimbSlideIterations, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Climbers"), STAT_ClimbActiveClimbers, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Climb Montage Load Latency (ms)"), STAT_ClimbMontageLoadLatency, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Climb Montage Sync Loads"), STAT_ClimbMontageSyncLoads, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb RepGraph Reduced Rate"), STAT_ClimbRepGraphReducedRate, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Climb RepGraph Gather"), STAT_ClimbRepGraphGather, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Client Corrections"), STAT_ClimbClientCorrections, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Replay Probes Reused"), STAT_ClimbReplayProbesReused, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Auto Traversal Queries"), STAT_ClimbAutoTraversalQueries, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Climb Intent Latency (ms)"), STAT_ClimbIntentLatency, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Redundant Probes Skipped"), STAT_ClimbRedundantProbesSkipped, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Climb Nav Build"), STAT_ClimbNavBuild, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Climb Nav Path Query"), STAT_ClimbNavPathQuery, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Nav Path Cache Hits"), STAT_ClimbNavPathCacheHits, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Nav Path Cache Misses"), STAT_ClimbNavPathCacheMisses, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Surface Material Cache Hits"), STAT_ClimbSurfaceMaterialCacheHits, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Surface Material Cache Misses"), STAT_ClimbSurfaceMaterialCacheMisses, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb IK Queries"), STAT_ClimbIKQueries, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Camera Probes"), STAT_ClimbCameraProbes, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Streaming Holds"), STAT_ClimbStreamingHolds, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Move Sweeps"), STAT_ClimbMoveSweeps, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Intents Expired"), STAT_ClimbIntentsExpired, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Schedule Climb Queries"), STAT_ClimbScheduleQueries, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
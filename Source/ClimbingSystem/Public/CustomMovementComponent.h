@@ -1,214 +1,1025 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/CharacterMovementComponent.h"
-#include "CustomMovementComponent.generated.h"
-
-/**
- * Enhance movement component implementing advanced climbing mechanics
- * 
- * Handles surface dectection, climb validation and movement excution
- */
-class UAnimMontage;
-class UAnimInstance;
-
-UENUM(BlueprintType)
-namespace ECustomMovementMode{
-	enum Type
-	{
-		MOVE_Climb UMETA(DisplayName = "Climb Mode")
-	};
-}
-
-UCLASS()
-class CLIMBINGSYSTEM_API UCustomMovementComponent : public UCharacterMovementComponent
-{
-	GENERATED_BODY()
-
-protected:
-	//~ Begin UCharacterMovementComponent Interface
-	virtual void BeginPlay() override;
-
-	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, 
-		FActorComponentTickFunction* ThisTickFunction) override;
-
-	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode,
-		uint8 PreviousCustomMode) override;
-
-	virtual void PhysCustom(float deltaTime, int32 Iterations) override;
-
-	virtual float GetMaxSpeed() const override;
-
-	virtual float GetMaxAcceleration() const override;
-
-	virtual FVector ConstrainAnimRootMotionVelocity(const FVector& RootMotionVelocity, const FVector& CurrentVelocity) const override;
-	//~ End UCharacterMovementComponent Interface
-
-public:
-	/** Checks if character is currently climbing */
-	bool IsClimbing() const;
-
-	/** Toggles climbing state based on input */
-	void ToggleToClimbing(bool bEnableClimb);
-
-	FORCEINLINE FVector GetClimbableSurfaceNormal() const { return CurrentClimbableSurfaceNormal; }
-
-	FVector GetUnrotatedClimbVelocity() const;
-
-private:
-	/** --------------------------------------------------------------------------
-	 *  Climbing System Components
-	 *  -------------------------------------------------------------------------- */
-
-#pragma region ClimbTraces
-	// ReSharper disable once CppDoxygenUnresolvedReference
-	// ReSharper disable once CppDoxygenUnresolvedReference
-	/**
-	* Performs capsule-based multi-object tracing for climb surfaces
-	* @param Start - Trace start position
-	* @param End - Trace end position
-	* @param bShowDebug - Visualize debug shapes
-	* @param bPersistentDebug - Keep debug shapes persistent
-	*/
-	TArray<FHitResult> DoCapsuleTraceMultiByObject(
-		const FVector& Start, 
-		const FVector& End, 
-		bool bShowDebugShape = false,
-		bool bDrawPresistantShapes = false);
-
-	/**
-	 * Performs precise line trace for surface validation
-	 * @param Start - Trace start position
-	 * @param End - Trace end position
-	 * @param bShowDebug - Visualize debug line
-	 * @param bPersistentDebug - Keep debug line persistent
-	 */
-	FHitResult DoLineTraceSingleByObject(
-		const FVector& Start,
-		const FVector& End,
-		bool bShowDebugShape = false,
-		bool bDrawPresistantShapes = false);
-#pragma endregion
-
-#pragma region ClimbCore
-private:
-	/** Main surface detection routine */
-	bool TraceClimbaleSurface();
-
-	/**
-	* Vertical surface scanning from eye level
-	* @param TraceDistance - Maximum detection range (cm)
-	* @param EyeHeightOffset - Vertical adjustment from base eye height (cm)
-	*/
-	FHitResult TraceFromEyeHeight(float TraceDistance, float EyeHeightOffset = 0.f);
-
-	/** Determines if character can start climbing */
-	bool CanStartClimbing();
-
-	/** Determind if character can climb down the ledge */
-	bool CanClimbDownLedge();
-
-	/** Enters climbing state */
-	void StartClimbing();
-
-	/** Exits climbing state */
-	void StopClimbing();
-
-	void PhysClimb(float deltaTime, int32 Iterations);
-
-	void ProcessClimbaleSurfaceInfo();
-
-	bool CheckShouldStopClimbing();
-
-	bool CheckHasReachedFloor();
-
-	bool CheckHasReachedLedge();
-
-	FQuat GetClimbRotation(float DeltaTime);
-
-	void SnapMovementToClimbableSurfaces(float DeltaTime);
-
-	void PlayClimbMontage(UAnimMontage* MontageToPlay);
-
-	UFUNCTION()
-	void OnClimbMontageEnded(UAnimMontage* Montage, bool bInterrupted);
-#pragma endregion
-
-#pragma region ClimbCoreVariables
-	/** Results from last climbable surface detection */
-	TArray<FHitResult> ClimbableSurfacesTraceResults;
-
-	FVector CurrentClimbableSurfaceLocation;
-
-	FVector CurrentClimbableSurfaceNormal;
-
-	UPROPERTY()
-	UAnimInstance* OwningPlayerAnimInstance;
-
-#pragma endregion
-
-#pragma region ClimbBPVariables
-	/** Object types considered climbable surfaces */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, 
-		Category = "Character Movement: Climbing", 
-		meta = (AllowPrivateAccess = "true"))
-	TArray<TEnumAsByte<EObjectTypeQuery> > ClimbableSurfaceTraceTypes;
-
-	/** Radius of capsule used for climb detection */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, 
-		Category = "Character Movement: Climbing", 
-		meta = (AllowPrivateAccess = "true"))
-	float ClimbCapsuleTraceRadius{50.f};
-
-	/** Half height of capsule used for climb detection */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, 
-		Category = "Character Movement: Climbing", 
-		meta = (AllowPrivateAccess = "true"))
-	float ClimbCapsuleTraceHalfHeight{72.f};
-
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
-		Category = "Character Movement: Climbing",
-		meta = (AllowPrivateAccess = "true"))
-	float MaxBreakClimbDeceleration{400.f};
-
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
-		Category = "Character Movement: Climbing",
-		meta = (AllowPrivateAccess = "true"))
-	float MaxClimbSpeed{100.f};
-
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
-		Category = "Character Movement: Climbing",
-		meta = (AllowPrivateAccess = "true"))
-	float MaxClimbAcceleration{300.f};
-
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
-		Category = "Character Movement: Climbing",
-		meta = (AllowPrivateAccess = "true"))
-	float ClimbDownSurfaceTraceOffset{300.f};
-
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
-		Category = "Character Movement: Climbing",
-		meta = (AllowPrivateAccess = "true"))
-	float ClimbDownLedgeSurfaceTraceOffset{300.f};
-
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
-		Category = "Character Movement: Climbing",
-		meta = (AllowPrivateAccess = "true"))
-	UAnimMontage* IdleToClimbMontage;
-
-
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
-		Category = "Character Movement: Climbing",
-		meta = (AllowPrivateAccess = "true"))
-	UAnimMontage* ClimbToTopMontage;
-
-	UPROPERTY(EditDefaultsOnly,BlueprintReadOnly,
-		Category = "Character Movement: Climbing", 
-		meta = (AllowPrivateAccess = "true"))
-	UAnimMontage* ClimbDownLedgeMontage;
-
-#pragma endregion
-
-};
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "ClimbTelemetry.h"
+#include "ClimbSurfacePhysicalMaterial.h"
+#include "WorldPartition/WorldPartitionStreamingSource.h"
+#include "CustomMovementComponent.generated.h"
+
+/**
+ * Enhance movement component implementing advanced climbing mechanics
+ * 
+ * Handles surface dectection, climb validation and movement excution
+ */
+class UAnimMontage;
+class UAnimInstance;
+class UClimbQueryBudgetSubsystem;
+class UClimbRootMotionTable;
+class UInstancedStaticMeshComponent;
+struct FStreamableHandle;
+
+UENUM(BlueprintType)
+namespace ECustomMovementMode{
+	enum Type
+	{
+		MOVE_Climb UMETA(DisplayName = "Climb Mode"),
+		MOVE_LedgeHang UMETA(DisplayName = "Ledge Hang Mode"),
+		MOVE_ClimbHop UMETA(DisplayName = "Climb Hop Mode"),
+		MOVE_WallRun UMETA(DisplayName = "Wall Run Mode"),
+		MOVE_MAX UMETA(Hidden)
+	};
+}
+
+/** Climbable surface sampled by the shared probe, used by every climb traversal mode */
+USTRUCT(BlueprintType)
+struct FClimbSurfaceInfo
+{
+	GENERATED_BODY()
+
+	/** Average impact point of the probe hits */
+	UPROPERTY(BlueprintReadOnly, Category = "Climbing")
+	FVector Location{FVector::ZeroVector};
+
+	/** Normalized average impact normal of the probe hits */
+	UPROPERTY(BlueprintReadOnly, Category = "Climbing")
+	FVector Normal{FVector::ZeroVector};
+
+	/** True if a walkable ledge was found above eye height */
+	UPROPERTY(BlueprintReadOnly, Category = "Climbing")
+	bool bHasLedgeAbove{false};
+};
+
+/**
+ * Compact record of one climb probe hit
+ *
+ * Holds only what the solver reads from an FHitResult, at a fraction of its size.
+ */
+struct FClimbSurfaceSample
+{
+	FVector ImpactPoint{FVector::ZeroVector};
+
+	FVector3f ImpactNormal{FVector3f::ZeroVector};
+
+	/** Unique id of the hit component, 0 if there was none */
+	uint32 ComponentId{0};
+
+	/** Item of the hit, the instance index on instanced static meshes */
+	int32 Item{INDEX_NONE};
+
+	/** Unique id of the physical material hit, 0 unless the probe asked for physical materials */
+	uint32 MaterialId{0};
+
+	static FClimbSurfaceSample FromHit(const FHitResult& Hit);
+};
+
+/**
+ * Climbed surface published for animation once per tick
+ *
+ * Covers the area the surface probe swept, so limb placement can reuse the probe hits instead
+ * of tracing again.
+ */
+struct FClimbSurfacePatch
+{
+	/** Estimated surface point, center of the probed area */
+	FVector Location{FVector::ZeroVector};
+
+	/** Estimated surface normal, zero when not climbing */
+	FVector Normal{FVector::ZeroVector};
+
+	/** Half size of the probed area across and up the surface */
+	FVector2f HalfExtent{FVector2f::ZeroVector};
+
+	/** Probe hits the estimate was made from */
+	TArray<FClimbSurfaceSample, TInlineAllocator<8>> Samples;
+
+	FORCEINLINE bool IsValid() const { return !Normal.IsZero(); }
+
+	/**
+	 * Projects Point onto the plane of the closest probe hit
+	 * @return false if Point is outside of the probed area, the outputs are left untouched then
+	 */
+	bool ProjectPoint(const FVector& Point, FVector& OutLocation, FVector& OutNormal) const;
+
+	/** Projects Point onto the plane of the closest of Samples, false if there are none */
+	static bool ProjectPointOntoSamples(TConstArrayView<FClimbSurfaceSample> Samples, const FVector& Point,
+		FVector& OutLocation, FVector& OutNormal);
+};
+
+/**
+ * Compact climb state of one character
+ *
+ * Sent with every server correction so replayed moves resume from the server's surface, anchor and
+ * mode timers instead of the client's mispredicted ones. Climb transitions are not part of it, the
+ * character movement component already corrects montage and root motion source positions.
+ */
+USTRUCT()
+struct FClimbStateSnapshot
+{
+	GENERATED_BODY()
+
+	/** ECustomMovementMode while in a climb traversal, MOVE_MAX otherwise */
+	uint8 CustomMode{ECustomMovementMode::MOVE_MAX};
+
+	/** Climbed surface */
+	FVector SurfaceLocation{FVector::ZeroVector};
+
+	FVector SurfaceNormal{FVector::ZeroVector};
+
+	bool bHasLedgeAbove{false};
+
+	/** Location of the last climb update, cached surface data is carried from here */
+	FVector Anchor{FVector::ZeroVector};
+
+	/** Seconds left of the climb hop or wall run */
+	float ModeTimeRemaining{0.f};
+
+	/** 1 for right, -1 for left, 0 when not wall running */
+	int8 WallRunSide{0};
+
+	FORCEINLINE bool IsInClimbTraversal() const { return CustomMode < ECustomMovementMode::MOVE_MAX; }
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FClimbStateSnapshot> : public TStructOpsTypeTraitsBase2<FClimbStateSnapshot>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/**
+ * Outcome of the surface probe of one climb update, kept with the saved move
+ *
+ * Replays of the move reuse it instead of tracing again while they stay on the recorded path.
+ */
+struct FClimbProbeRecord
+{
+	/** Component location at the start of the update */
+	FVector Location{FVector::ZeroVector};
+
+	FVector3f ProbeDirection{FVector3f::ZeroVector};
+
+	/** Probe hits, empty if the update carried the cached surface along */
+	TArray<FClimbSurfaceSample> Samples;
+
+	/** Component the climber was on, 0 if none */
+	uint32 SurfaceComponentId{0};
+
+	bool bProbed{false};
+
+	bool bHasLedgeAbove{false};
+};
+
+/** Move response carrying the server's climb state with every correction */
+struct FClimbMoveResponseDataContainer : public FCharacterMoveResponseDataContainer
+{
+	virtual void ServerFillResponseData(const UCharacterMovementComponent& CharacterMovement,
+		const FClientAdjustment& PendingAdjustment) override;
+
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap) override;
+
+	FClimbStateSnapshot ClimbState;
+};
+
+/** Step of the time sliced auto mantle and ledge grab probe, one query per frame */
+enum class EClimbAutoTraversalStage : uint8
+{
+	Idle,
+	/** Looking for a wall ahead, at the waist when running and at the eyes when falling */
+	WallAhead,
+	/** Running only, the wall must end below eye height */
+	Clearance,
+	/** Running only, looking down onto the top of the obstacle */
+	MantleTop,
+	/** Falling only, confirms the ledge and grabs it */
+	LedgeGrab
+};
+
+/** Climb basis derived once per update and shared by every consumer */
+struct FClimbFrame
+{
+	FQuat Rotation{FQuat::Identity};
+
+	/** Velocity in the component's local space */
+	FVector UnrotatedVelocity{FVector::ZeroVector};
+
+	/** Velocity UnrotatedVelocity was derived from, a mismatch means Velocity was written since */
+	FVector SourceVelocity{FVector::ZeroVector};
+
+	/** Rotation facing into the climbed surface, target of GetClimbRotation */
+	FQuat SurfaceRotation{FQuat::Identity};
+
+	/** Cosine of the angle between the surface normal and world up */
+	float SurfaceUpDot{0.f};
+};
+
+UCLASS()
+class CLIMBINGSYSTEM_API UCustomMovementComponent : public UCharacterMovementComponent,
+	public IWorldPartitionStreamingSourceProvider
+{
+	GENERATED_BODY()
+
+protected:
+	//~ Begin UCharacterMovementComponent Interface
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, 
+		FActorComponentTickFunction* ThisTickFunction) override;
+
+	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode,
+		uint8 PreviousCustomMode) override;
+
+	virtual void PhysCustom(float deltaTime, int32 Iterations) override;
+
+	virtual float GetMaxSpeed() const override;
+
+	virtual float GetMaxAcceleration() const override;
+
+	virtual FVector ConstrainAnimRootMotionVelocity(const FVector& RootMotionVelocity, const FVector& CurrentVelocity) const override;
+
+	virtual bool ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel,
+		const FVector& ClientWorldLocation, const FVector& RelativeClientLocation,
+		UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode) override;
+
+	virtual void ClientHandleMoveResponse(const FCharacterMoveResponseDataContainer& MoveResponse) override;
+
+	virtual bool ClientUpdatePositionAfterServerUpdate() override;
+
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+	//~ End UCharacterMovementComponent Interface
+
+public:
+	UCustomMovementComponent(const FObjectInitializer& ObjectInitializer);
+
+	//~ Begin UCharacterMovementComponent Interface
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+
+	virtual void StopMovementImmediately() override;
+	//~ End UCharacterMovementComponent Interface
+
+	//~ Begin IWorldPartitionStreamingSourceProvider Interface
+	virtual bool GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const override;
+
+	virtual const UObject* GetStreamingSourceOwner() const override;
+	//~ End IWorldPartitionStreamingSourceProvider Interface
+
+	/** Checks if character is currently climbing */
+	bool IsClimbing() const;
+
+	/** Checks if character is in any of the custom traversal modes */
+	bool IsInClimbTraversal() const;
+
+	bool IsLedgeHanging() const;
+
+	bool IsWallRunning() const;
+
+	/**
+	 * True for player controlled climbers, which always probe. The client probes every predicted
+	 * move, so the server must not skip probes on its ServerMoves. Only AI and simulated climbers
+	 * are budgeted.
+	 */
+	bool IsExemptFromClimbQueryBudget() const;
+
+	/**
+	 * Toggles climbing state based on input
+	 *
+	 * A climb request that cannot start right away is kept for ClimbIntentGraceWindow seconds and
+	 * retried every tick until it succeeds.
+	 */
+	void ToggleToClimbing(bool bEnableClimb);
+
+	FORCEINLINE bool HasPendingClimbIntent() const { return bClimbIntentPending; }
+
+	/** Hops along the climbed surface in the input direction, returns true if the hop started */
+	bool RequestClimbHop();
+
+	/** True if jump input should hop, leave the wall run or try to start one instead of jumping */
+	bool CanClimbJump() const;
+
+	/** Hops, leaves or starts a wall run with the next move, on the client and again on the server */
+	FORCEINLINE void RequestClimbJump() { bWantsClimbJump = true; }
+
+	/** Climb jump requested for the next move, sent to the server as FLAG_Custom_2 */
+	FORCEINLINE bool WantsClimbJump() const { return bWantsClimbJump; }
+
+	/** Grabs the ledge in front of the character, returns true if now hanging */
+	bool TryStartLedgeHang();
+
+	/** Starts running along a wall beside the falling character, returns true if now wall running */
+	bool TryStartWallRun();
+
+	/** Leaves the wall run, optionally pushing off the wall */
+	void StopWallRun(bool bJumpOff);
+
+	FORCEINLINE FVector GetClimbableSurfaceNormal() const { return CurrentClimbableSurface.Normal; }
+
+	FORCEINLINE const FClimbSurfaceInfo& GetClimbableSurfaceInfo() const { return CurrentClimbableSurface; }
+
+	/** Surface patch of the last tick, for limb placement */
+	FORCEINLINE const FClimbSurfacePatch& GetClimbSurfacePatch() const { return ClimbSurfacePatch; }
+
+	/**
+	 * Sweeps Shape against climbable geometry, for queries outside of the movement update
+	 * @param OutSamples - One sample per hit surface
+	 */
+	void SweepClimbableSurfaces(const FVector& Start, const FVector& End, const FQuat& Rotation,
+		const FCollisionShape& Shape, TArray<FClimbSurfaceSample>& OutSamples) const;
+
+	FORCEINLINE const TArray<TEnumAsByte<EObjectTypeQuery>>& GetClimbableSurfaceTraceTypes() const { return ClimbableSurfaceTraceTypes; }
+
+	FORCEINLINE bool UsesClimbableTraceChannel() const { return bUseClimbableTraceChannel; }
+
+	/** Climb properties of the surface being climbed, from its UClimbSurfacePhysicalMaterial */
+	FORCEINLINE const FClimbSurfaceProperties& GetClimbSurfaceProperties() const { return CurrentClimbSurfaceProperties; }
+
+	/** Drops the cached surface properties, for gameplay that swaps physical materials at runtime */
+	void InvalidateClimbSurfaceMaterialCache();
+
+	/** Ring buffer of the last climb updates, for post-mortem debugging */
+	FORCEINLINE const FClimbTelemetryRingBuffer& GetClimbTelemetry() const { return ClimbTelemetry; }
+
+	/** Heap memory owned by the climbing state of this component */
+	SIZE_T GetClimbAllocatedSize() const;
+
+	//~ Begin UObject Interface
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+	//~ End UObject Interface
+
+	/** Velocity in the climber's local space, cached once per climb update and rederived if Velocity changed since */
+	FVector GetUnrotatedClimbVelocity() const;
+
+	/** Client moves the server rejected since BeginPlay, only counted on the server */
+	FORCEINLINE uint32 GetNumClientCorrections() const { return NumClientCorrections; }
+
+	/** Times the character got on or off a climbable surface since BeginPlay, for flapping detection */
+	FORCEINLINE uint32 GetNumClimbTraversalChanges() const { return NumClimbTraversalChanges; }
+
+	/** True while the climber waits, on the server, at a world partition cell that is still streaming in */
+	FORCEINLINE bool IsHoldingForClimbStreaming() const { return bHoldingForClimbStreaming; }
+
+	/** Physics queries issued by one climb probe (surface, floor, eye and ledge traces) */
+	static constexpr int32 ClimbProbeQueryCost{4};
+
+	/** Auto mantle decided by the locally controlled side, sent to the server with the next move */
+	FORCEINLINE bool WantsAutoMantle() const { return bWantsAutoMantle; }
+
+	/** Auto ledge grab decided by the locally controlled side, sent to the server with the next move */
+	FORCEINLINE bool WantsAutoLedgeGrab() const { return bWantsAutoLedgeGrab; }
+
+	FClimbStateSnapshot CaptureClimbStateSnapshot() const;
+
+	/** Restores the server's climb state after a correction, ignored outside of climb traversal */
+	void ApplyClimbStateSnapshot(const FClimbStateSnapshot& Snapshot);
+
+	/** Hands over the probes recorded since the last call, one per climb update */
+	TArray<FClimbProbeRecord> ConsumeRecordedClimbProbes();
+
+	/** Probes the next replayed move may reuse, in update order */
+	void SetReplayedClimbProbes(TConstArrayView<FClimbProbeRecord> Probes);
+
+private:
+	/** --------------------------------------------------------------------------
+	 *  Climbing System Components
+	 *  -------------------------------------------------------------------------- */
+
+#pragma region ClimbTraces
+	// ReSharper disable once CppDoxygenUnresolvedReference
+	// ReSharper disable once CppDoxygenUnresolvedReference
+	/**
+	* Performs capsule-based multi-object tracing for climb surfaces
+	* @param Start - Trace start position
+	* @param End - Trace end position
+	* @param bReturnPhysicalMaterial - Fill in the physical material of the hits
+	* @param bShowDebug - Visualize debug shapes
+	* @param bPersistentDebug - Keep debug shapes persistent
+	*/
+	TArray<FHitResult> DoCapsuleTraceMultiByObject(
+		const FVector& Start, 
+		const FVector& End, 
+		bool bReturnPhysicalMaterial,
+		bool bShowDebugShape = false,
+		bool bDrawPresistantShapes = false);
+
+	/**
+	 * Performs precise line trace for surface validation
+	 * @param Start - Trace start position
+	 * @param End - Trace end position
+	 * @param bShowDebug - Visualize debug line
+	 * @param bPersistentDebug - Keep debug line persistent
+	 */
+	FHitResult DoLineTraceSingleByObject(
+		const FVector& Start,
+		const FVector& End,
+		bool bShowDebugShape = false,
+		bool bDrawPresistantShapes = false);
+
+	/** Physics queries issued by the climb traces since BeginPlay */
+	mutable uint32 NumClimbQueriesIssued{0};
+#pragma endregion
+
+#pragma region ClimbSurfaceMaterials
+	/** Climb properties of a surface and the physical material they were resolved from */
+	struct FClimbSurfaceMaterialEntry
+	{
+		TWeakObjectPtr<const UPhysicalMaterial> PhysicalMaterial;
+
+		FClimbSurfaceProperties Properties;
+
+		/** Set for instanced meshes whose instances scale Properties, see FClimbInstanceData */
+		TWeakObjectPtr<const UInstancedStaticMeshComponent> InstancedComponent;
+
+		/**
+		 * Sections or landscape layers may use different physical materials, Properties only holds the
+		 * first one seen and each hit is resolved through ClimbPhysicalMaterialCache instead
+		 */
+		bool bMultiMaterial{false};
+	};
+
+	/** Resolves and caches the properties of a probed component, unless cached from the same material */
+	void CacheClimbSurfaceMaterial(const FClimbSurfaceSample& Sample, const UPrimitiveComponent* Component,
+		const UPhysicalMaterial* PhysicalMaterial);
+
+	/** True if hits on Component can report different physical materials */
+	static bool HasMultipleClimbSurfaceMaterials(const UPrimitiveComponent* Component);
+
+	/** Combines the cached properties of the probed surfaces into CurrentClimbSurfaceProperties */
+	void ResolveClimbSurfaceProperties();
+
+	/** Component id to the climb properties of its surface */
+	TMap<uint32, FClimbSurfaceMaterialEntry> ClimbSurfaceMaterialCache;
+
+	/** Physical material id to its climb properties, filled from hits on multi material components */
+	TMap<uint32, FClimbSurfaceProperties> ClimbPhysicalMaterialCache;
+
+	/** The last resolving probe hit a multi material component, probes keep asking for physical materials */
+	bool bProbingMultiMaterialSurface{false};
+
+	FClimbSurfaceProperties CurrentClimbSurfaceProperties;
+
+	/** A probed component had no cache entry, the next surface probe asks for physical materials */
+	bool bClimbSurfaceMaterialCacheMiss{true};
+#pragma endregion
+
+#pragma region ClimbCore
+private:
+	/** Main surface detection routine */
+	bool TraceClimbaleSurface();
+
+	/** Direction the surface probe looks in, forward or towards the wall run side */
+	FVector GetClimbProbeDirection() const;
+
+	/** Checks for a walkable ledge above eye height */
+	bool TraceLedgeAbove();
+
+	/**
+	* Vertical surface scanning from eye level
+	* @param TraceDistance - Maximum detection range (cm)
+	* @param EyeHeightOffset - Vertical adjustment from base eye height (cm)
+	*/
+	FHitResult TraceFromEyeHeight(float TraceDistance, float EyeHeightOffset = 0.f);
+
+	/** Determines if character can start climbing */
+	bool CanStartClimbing();
+
+	/** Determind if character can climb down the ledge */
+	bool CanClimbDownLedge();
+
+	/** Enters climbing state */
+	void StartClimbing();
+
+	/** Exits climbing state */
+	void StopClimbing();
+
+	void PhysClimb(float deltaTime, int32 Iterations);
+
+	void PhysLedgeHang(float deltaTime, int32 Iterations);
+
+	void PhysClimbHop(float deltaTime, int32 Iterations);
+
+	void PhysWallRun(float deltaTime, int32 Iterations);
+
+	using FPhysCustomModeFunc = void (UCustomMovementComponent::*)(float, int32);
+
+	/** Physics update of each custom mode, indexed by ECustomMovementMode */
+	static const FPhysCustomModeFunc PhysCustomModeTable[ECustomMovementMode::MOVE_MAX];
+
+	/**
+	 * Shared probe pipeline of all traversal modes, refreshes CurrentClimbableSurface
+	 * @param DeltaTime - Time step used to filter the surface normal
+	 * @return true if the surface was probed this update, false if cached data was reused
+	 */
+	bool UpdateClimbSurfaceInfo(float DeltaTime);
+
+	/**
+	 * Takes the recorded probe of the update being replayed
+	 * @return nullptr outside of replays, or if the replay left the recorded path or surface
+	 */
+	const FClimbProbeRecord* ConsumeReplayedClimbProbe();
+
+	/** Asks the query budget scheduler whether this climber may probe this frame */
+	bool ConsumeClimbQueryBudget() const;
+
+	/**
+	 * Sweeps along the surface with the current velocity while snapping onto it
+	 *
+	 * The move is split into GetNumClimbSubsteps steps, each sweeping its share of the move and of
+	 * the snap at once.
+	 */
+	void MoveAlongClimbSurface(float deltaTime, int32 Iterations);
+
+	/** Substeps needed for the current velocity and surface curvature, at most the iterations left */
+	int32 GetNumClimbSubsteps(float deltaTime, int32 Iterations) const;
+
+	/**
+	* Estimates the climbed surface from the probe hits
+	* @param DeltaTime - Time step of the temporal normal filter, 0 takes the new normal as is
+	*/
+	void ProcessClimbaleSurfaceInfo(float DeltaTime);
+
+	bool CheckShouldStopClimbing();
+
+	bool CheckHasReachedFloor();
+
+	bool CheckHasReachedLedge();
+
+	FQuat GetClimbRotation(float DeltaTime);
+
+	/** Caches rotation and local velocity after the component moved */
+	void RefreshClimbFrame();
+
+	/** Caches the surface facing rotation after the surface normal changed */
+	void RefreshClimbSurfaceFrame();
+
+	void SnapMovementToClimbableSurfaces(float DeltaTime);
+
+	/** @return true if the montage or its baked root motion started */
+	bool PlayClimbMontage(const TSoftObjectPtr<UAnimMontage>& MontageToPlay);
+
+	UFUNCTION()
+	void OnClimbMontageEnded(UAnimMontage* Montage, bool bInterrupted);
+
+	/** Applies the end of a climb transition, whether it was animated or played from baked root motion */
+	void OnClimbTransitionFinished(const FSoftObjectPath& MontagePath);
+
+	/** True while a climb montage or its baked root motion is driving the character */
+	bool IsPlayingClimbTransition() const;
+#pragma endregion
+
+#pragma region ClimbBakedRootMotion
+	/** True when climb transitions should play from ClimbRootMotionTable instead of the anim instance */
+	bool ShouldUseBakedClimbRootMotion() const;
+
+	/** @return false if the montage has no baked track */
+	bool PlayBakedClimbRootMotion(const TSoftObjectPtr<UAnimMontage>& Montage);
+
+	/** Synthesizes the montage end once the baked root motion source has finished */
+	void UpdateBakedClimbRootMotion();
+
+	/** Root motion source id of the baked transition in flight, 0 when none */
+	uint16 BakedClimbRootMotionId{0};
+
+	FSoftObjectPath BakedClimbMontagePath;
+#pragma endregion
+
+#pragma region ClimbIntent
+	/** Starts the climb or climb down transition if possible, without probing again where the last attempt failed */
+	bool TryStartClimbTransition();
+
+	/** Retries the buffered climb request until it succeeds or the grace window runs out */
+	void UpdateClimbIntent(float DeltaTime);
+
+	void ClearClimbIntent();
+
+	bool bClimbIntentPending{false};
+
+	float ClimbIntentTimeRemaining{0.f};
+
+	/** Platform time of the first request, for the intent latency stat */
+	double ClimbIntentRequestTime{0.0};
+
+	/** Pose of the last climb start probe that failed, retries from the same pose skip the queries */
+	bool bHasFailedClimbStartProbe{false};
+
+	FVector FailedClimbStartProbeLocation{FVector::ZeroVector};
+
+	FVector FailedClimbStartProbeForward{FVector::ZeroVector};
+#pragma endregion
+
+#pragma region ClimbAutoTraversal
+	/**
+	 * Advances the auto mantle and ledge grab probe by one step
+	 *
+	 * Only the locally controlled side probes. What it decides is performed with the next move, on
+	 * the client and again on the server, see PerformAutoClimbTraversal.
+	 */
+	void UpdateAutoClimbTraversal(float DeltaTime);
+
+	/** True while the character moves in a way that could end in a mantle or ledge grab */
+	bool ShouldProbeAutoClimbTraversal() const;
+
+	/** Looks down onto the obstacle ahead, true if its top can be stood on */
+	bool TraceAutoMantleTop();
+
+	/** Starts the mantle or ledge grab requested for the current move */
+	void PerformAutoClimbTraversal();
+
+	/** Hops, leaves or starts the wall run requested for the current move */
+	void PerformClimbJump();
+
+	bool bWantsClimbJump{false};
+
+	bool bWantsAutoMantle{false};
+
+	bool bWantsAutoLedgeGrab{false};
+
+	EClimbAutoTraversalStage AutoClimbStage{EClimbAutoTraversalStage::Idle};
+
+	float AutoClimbProbeTimer{0.f};
+#pragma endregion
+
+#pragma region ClimbMontageStreaming
+	/**
+	 * Periodically checks for climbable geometry within ClimbMontagePreloadRadius
+	 *
+	 * Starts streaming the climb montages the first time some is found, and gates auto traversal.
+	 */
+	void UpdateClimbProximity(float DeltaTime);
+
+	void RequestClimbMontagePreload();
+
+	void OnClimbMontagesLoaded();
+
+	/** Returns the loaded montage, loading it synchronously if the async preload has not finished */
+	UAnimMontage* ResolveClimbMontage(const TSoftObjectPtr<UAnimMontage>& Montage);
+
+	/** Keeps the climb montages resident once requested */
+	TSharedPtr<FStreamableHandle> ClimbMontageLoadHandle;
+
+	/** Platform time the async preload was requested, for the load latency stat */
+	double ClimbMontageLoadRequestTime{0.0};
+
+	float ClimbMontagePreloadCheckTimer{0.f};
+
+	/** Result of the last proximity check */
+	bool bNearClimbableSurface{false};
+#pragma endregion
+
+#pragma region ClimbWorldStreaming
+	/**
+	 * Decides whether an empty surface probe is a cell that has not streamed in yet
+	 *
+	 * Climbing and ledge hanging keep the last surface instead of falling while the world partition
+	 * cell under it is loading, for at most ClimbStreamingHoldTimeout seconds. Only the server stops
+	 * in place, clients keep moving on the last surface.
+	 * @return true if the last surface should be kept
+	 */
+	bool ShouldHoldForClimbStreaming(float DeltaTime);
+
+	/** True if a world partition cell under the current climbable surface is not activated yet */
+	bool IsClimbSurfaceCellStreaming() const;
+
+	/** Name of the streaming source raised while climbing, unique per character */
+	FName ClimbStreamingSourceName;
+
+	bool bClimbStreamingSourceRegistered{false};
+
+	/** The probe lost the surface inside a cell that is still streaming in, the last surface is kept */
+	bool bClimbSurfaceStreaming{false};
+
+	/** Server side, the climber stops in place until the cell has streamed in */
+	bool bHoldingForClimbStreaming{false};
+
+	float ClimbStreamingHoldTime{0.f};
+#pragma endregion
+
+#pragma region ClimbCoreVariables
+	/** Results from last climbable surface detection */
+	TArray<FClimbSurfaceSample> ClimbableSurfacesTraceResults;
+
+	FClimbSurfaceInfo CurrentClimbableSurface;
+
+	FClimbFrame ClimbFrame;
+
+	/** Copy of the surface handed to animation, see PublishClimbSurfacePatch */
+	FClimbSurfacePatch ClimbSurfacePatch;
+
+	/** Refreshes ClimbSurfacePatch after the movement update */
+	void PublishClimbSurfacePatch();
+
+	/**
+	 * Probes the climbed surface of a rendered simulated proxy every SimulatedClimbProbeInterval
+	 *
+	 * Proxies never run PhysClimb, without this their surface patch stays empty and limb IK is off.
+	 */
+	void UpdateSimulatedClimbSurface(float DeltaTime);
+
+	float SimulatedClimbProbeTimer{0.f};
+
+	/** Largest turn between the probe hit normals per centimeter of probed height, in radians */
+	float ClimbSurfaceCurvature{0.f};
+
+	/** Component location at the previous climb update, used to carry cached surface data */
+	FVector LastClimbUpdateLocation;
+
+	float ClimbHopTimeRemaining{0.f};
+
+	float WallRunTimeRemaining{0.f};
+
+	/** Side of the wall being run along, 1 for right and -1 for left, 0 when not wall running */
+	float WallRunSide{0.f};
+
+	UPROPERTY()
+	UAnimInstance* OwningPlayerAnimInstance;
+
+	UPROPERTY()
+	UClimbQueryBudgetSubsystem* ClimbQueryBudget;
+
+	uint32 NumClientCorrections{0};
+
+	uint32 NumClimbTraversalChanges{0};
+
+#pragma endregion
+
+#pragma region ClimbPrediction
+	FClimbMoveResponseDataContainer ClimbMoveResponseDataContainer;
+
+	/** Probes of the move being performed, moved into its saved move afterwards */
+	TArray<FClimbProbeRecord> RecordedClimbProbes;
+
+	/** Probes of the saved move being replayed, only valid during ClientUpdatePositionAfterServerUpdate */
+	TConstArrayView<FClimbProbeRecord> ReplayedClimbProbes;
+
+	int32 NextReplayedClimbProbe{0};
+#pragma endregion
+
+#pragma region ClimbTelemetry
+	/** Stamps Frame with the current state and records it */
+	void CommitClimbTelemetry(FClimbTelemetryFrame& Frame);
+
+	FClimbTelemetryRingBuffer ClimbTelemetry;
+
+	/** Frame filled in during the current climb update */
+	FClimbTelemetryFrame PendingClimbTelemetry;
+
+#if ENABLE_DRAW_DEBUG
+	FClimbTelemetryDebugRenderer ClimbTelemetryRenderer;
+#endif
+
+#pragma endregion
+
+#pragma region ClimbBPVariables
+	/** Object types considered climbable surfaces */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, 
+		Category = "Character Movement: Climbing", 
+		meta = (AllowPrivateAccess = "true"))
+	TArray<TEnumAsByte<EObjectTypeQuery> > ClimbableSurfaceTraceTypes;
+
+	/**
+	 * Probe the Climbable trace channel instead of ClimbableSurfaceTraceTypes
+	 *
+	 * Only geometry tagged climbable is considered, which keeps unclimbable clutter out of the
+	 * probe results on dense maps. See ClimbingSystemCollision.h.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	bool bUseClimbableTraceChannel{false};
+
+	/** Radius of capsule used for climb detection */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, 
+		Category = "Character Movement: Climbing", 
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbCapsuleTraceRadius{50.f};
+
+	/** Half height of capsule used for climb detection */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, 
+		Category = "Character Movement: Climbing", 
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbCapsuleTraceHalfHeight{72.f};
+
+	/** Seconds between surface probes of simulated proxies, for limb IK only */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float SimulatedClimbProbeInterval{0.1f};
+
+	/** Probe hits whose normal deviates more than this from the weighted mean are ignored (degrees) */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbSurfaceOutlierAngle{50.f};
+
+	/** Time constant of the surface normal low pass filter, 0 disables filtering */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbSurfaceNormalSmoothingTime{0.08f};
+
+	/** Replayed moves further than this from where their probe was recorded trace again */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbReplayProbeTolerance{10.f};
+
+	/** Surfaces whose climb properties are cached, the cache is flushed when it grows past this */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	int32 ClimbSurfaceMaterialCacheSize{64};
+
+	/** Longest distance a climb move substep may cover */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float MaxClimbSubstepDistance{20.f};
+
+	/** Largest turn of the surface a climb move substep may cover, in degrees */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float MaxClimbSubstepAngle{10.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float MaxBreakClimbDeceleration{400.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float MaxClimbSpeed{100.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float MaxClimbAcceleration{300.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbDownSurfaceTraceOffset{300.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbDownLedgeSurfaceTraceOffset{300.f};
+
+	/** Hang at the ledge when climbing up to it instead of mantling right away */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	bool bAutoHangAtLedge{false};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float MaxLedgeShimmySpeed{80.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbHopSpeed{350.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbHopDuration{0.35f};
+
+	/** Horizontal speed needed to start and keep a wall run */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float MinWallRunSpeed{300.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float MaxWallRunSpeed{700.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float MaxWallRunTime{1.5f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float WallRunGravityScale{0.25f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float WallRunJumpOffSpeed{450.f};
+
+	/**
+	 * Baked root motion of the climb montages
+	 *
+	 * When set, networked games play climb transitions from this table on the server and the owning
+	 * client alike, the montage only animates the pose. Dedicated servers stop ticking the mesh pose.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	UClimbRootMotionTable* ClimbRootMotionTable;
+
+	/**
+	 * Raise a high priority world partition streaming source ahead of the climber
+	 *
+	 * Cells the character climbs towards stream in before the surface probe reaches them, and
+	 * climbing holds at a cell that is still loading instead of falling off. Only used in
+	 * partitioned worlds.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	bool bRaiseClimbStreamingSource{true};
+
+	/** Distance ahead of the climber, along the climb input, the streaming source is centered at */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbStreamingLookAhead{1000.f};
+
+	/** Radius of the climb streaming source */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbStreamingSourceRadius{3000.f};
+
+	/** Seconds the climber holds at a cell still streaming in before falling anyway */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbStreamingHoldTimeout{5.f};
+
+	/** Seconds a climb request that could not start right away keeps being retried */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbIntentGraceWindow{0.3f};
+
+	/** Mantle obstacles and grab ledges automatically while running and falling */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	bool bAutoClimbTraversal{false};
+
+	/** Distance ahead of the character the auto traversal probe looks for walls */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float AutoClimbReach{75.f};
+
+	/** Forward ground speed needed before obstacles are mantled */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float AutoMantleMinSpeed{150.f};
+
+	/** Seconds between auto traversal probe sequences that found nothing */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float AutoClimbProbeInterval{0.1f};
+
+	/** Climbable geometry closer than this starts streaming the climb montages and enables auto traversal */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbMontagePreloadRadius{400.f};
+
+	/** Seconds between proximity checks while the montages are not requested yet */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	float ClimbMontagePreloadCheckInterval{0.5f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	TSoftObjectPtr<UAnimMontage> IdleToClimbMontage;
+
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly,
+		Category = "Character Movement: Climbing",
+		meta = (AllowPrivateAccess = "true"))
+	TSoftObjectPtr<UAnimMontage> ClimbToTopMontage;
+
+	UPROPERTY(EditDefaultsOnly,BlueprintReadOnly,
+		Category = "Character Movement: Climbing", 
+		meta = (AllowPrivateAccess = "true"))
+	TSoftObjectPtr<UAnimMontage> ClimbDownLedgeMontage;
+
+#pragma endregion
+
+};